@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <cdl/cdl.hpp>
+#include <cmath>
+#include <vector>
+
+// regular polygon around the mid, its corners are given as first argument
+static cdl::Polygon createRegularPolygon(const cdl::Vec2 &p_mid, const float p_radius, const int p_corners)
+{
+	cdl::Polygon result;
+	for(int i = 0; i < p_corners; ++i) {
+		float angle = 2 * M_PI * i / p_corners;
+		result.corners.push_back(p_mid + cdl::Vec2(p_radius * cos(angle), p_radius * sin(angle)));
+	}
+	return result;
+}
+
+static void BM_CollideCircles(benchmark::State &p_state)
+{
+	cdl::Circle circle1(cdl::Vec2(0, 0), 1);
+	cdl::Circle circle2(cdl::Vec2(1.5f, 0.5f), 1);
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideCircles(circle1, circle2, points));
+	}
+}
+BENCHMARK(BM_CollideCircles);
+
+static void BM_CollideLines(benchmark::State &p_state)
+{
+	cdl::Line line1(cdl::Vec2(0, 0), cdl::Vec2(1, 1));
+	cdl::Line line2(cdl::Vec2(0, 1), cdl::Vec2(1, 0.5f));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLines(line1, line2, points));
+	}
+}
+BENCHMARK(BM_CollideLines);
+
+static void BM_CollideLineSegments(benchmark::State &p_state)
+{
+	cdl::Line line1(cdl::Vec2(0, 0), cdl::Vec2(1, 1));
+	cdl::Line line2(cdl::Vec2(0, 1), cdl::Vec2(1, 0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLineSegments(line1, line2, points));
+	}
+}
+BENCHMARK(BM_CollideLineSegments);
+
+static void BM_CollideLineLineSegment(benchmark::State &p_state)
+{
+	cdl::Line line(cdl::Vec2(0, 0), cdl::Vec2(1, 1));
+	cdl::Line lineSegment(cdl::Vec2(0, 1), cdl::Vec2(1, 0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLineLineSegment(line, lineSegment, points));
+	}
+}
+BENCHMARK(BM_CollideLineLineSegment);
+
+static void BM_CollideLineCircle(benchmark::State &p_state)
+{
+	cdl::Line line(cdl::Vec2(-2, 0.5f), cdl::Vec2(2, 0));
+	cdl::Circle circle(cdl::Vec2(0, 0), 1);
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLineCircle(line, circle, points));
+	}
+}
+BENCHMARK(BM_CollideLineCircle);
+
+static void BM_CollideLineSegmentCircle(benchmark::State &p_state)
+{
+	cdl::Line line(cdl::Vec2(-2, 0.5f), cdl::Vec2(2, 0));
+	cdl::Circle circle(cdl::Vec2(0, 0), 1);
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLineSegmentCircle(line, circle, points));
+	}
+}
+BENCHMARK(BM_CollideLineSegmentCircle);
+
+static void BM_CollidePolygons(benchmark::State &p_state)
+{
+	cdl::Polygon polygon1 = createRegularPolygon(cdl::Vec2(0, 0), 1, p_state.range(0));
+	cdl::Polygon polygon2 = createRegularPolygon(cdl::Vec2(1, 0.5f), 1, p_state.range(0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collidePolygons(polygon1, polygon2, points));
+	}
+}
+BENCHMARK(BM_CollidePolygons)->Arg(4)->Arg(8)->Arg(32);
+
+static void BM_CollideLinePolygon(benchmark::State &p_state)
+{
+	cdl::Line line(cdl::Vec2(-2, 0.5f), cdl::Vec2(2, 0));
+	cdl::Polygon polygon = createRegularPolygon(cdl::Vec2(0, 0), 1, p_state.range(0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLinePolygon(line, polygon, points));
+	}
+}
+BENCHMARK(BM_CollideLinePolygon)->Arg(4)->Arg(8)->Arg(32);
+
+static void BM_CollideLineSegmentPolygon(benchmark::State &p_state)
+{
+	cdl::Line line(cdl::Vec2(-2, 0.5f), cdl::Vec2(2, 0));
+	cdl::Polygon polygon = createRegularPolygon(cdl::Vec2(0, 0), 1, p_state.range(0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideLineSegmentPolygon(line, polygon, points));
+	}
+}
+BENCHMARK(BM_CollideLineSegmentPolygon)->Arg(4)->Arg(8)->Arg(32);
+
+static void BM_CollideCirclePolygon(benchmark::State &p_state)
+{
+	cdl::Circle circle(cdl::Vec2(1, 0.5f), 1);
+	cdl::Polygon polygon = createRegularPolygon(cdl::Vec2(0, 0), 1, p_state.range(0));
+	std::vector<cdl::Vec2> points;
+	for(auto _ : p_state) {
+		points.clear();
+		benchmark::DoNotOptimize(cdl::collideCirclePolygon(circle, polygon, points));
+	}
+}
+BENCHMARK(BM_CollideCirclePolygon)->Arg(4)->Arg(8)->Arg(32);
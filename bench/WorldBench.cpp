@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <cdl/cdl.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+enum ShapeMix { MIX_CIRCLES, MIX_POLYGONS, MIX_BOTH };
+enum BroadphaseType { BROADPHASE_NONE, BROADPHASE_GRID, BROADPHASE_SWEEP_AND_PRUNE, BROADPHASE_TREE };
+
+static float randomFloat(const float p_min, const float p_max)
+{
+	return p_min + (p_max - p_min) * (rand() / (float) RAND_MAX);
+}
+
+/* Creates objects with a size of about 1 in a square, whose area is the
+ * number of objects divided by the density. Dense scenes therefore have
+ * the same number of neighbours per object at every object count. */
+static void createScene(cdl::World &p_world, const int p_count, const float p_density, const ShapeMix p_mix, const float p_speed)
+{
+	float halfSize = 0.5f * sqrt(p_count / p_density);
+	srand(1);
+	for(int i = 0; i < p_count; ++i) {
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		bool circle = p_mix == MIX_CIRCLES || (p_mix == MIX_BOTH && i % 2 == 0);
+		if(circle) {
+			circles.push_back(cdl::Circle(cdl::Vec2(0, 0), randomFloat(0.2f, 0.5f)));
+		} else {
+			cdl::Polygon polygon;
+			float halfWidth = randomFloat(0.2f, 0.5f);
+			polygon.corners.push_back(cdl::Vec2(-halfWidth, halfWidth));
+			polygon.corners.push_back(cdl::Vec2(halfWidth, halfWidth));
+			polygon.corners.push_back(cdl::Vec2(halfWidth, -halfWidth));
+			polygon.corners.push_back(cdl::Vec2(-halfWidth, -halfWidth));
+			polygons.push_back(polygon);
+		}
+
+		cdl::CollisionObject *object = p_world.createObject(polygons, circles);
+		object->position.set(randomFloat(-halfSize, halfSize), randomFloat(-halfSize, halfSize));
+		object->linearVelocity.set(randomFloat(-p_speed, p_speed), randomFloat(-p_speed, p_speed));
+		object->setDirection(randomFloat(0, 2 * M_PI));
+	}
+}
+
+/* Arguments are the number of objects, the density in objects per 100
+ * units of area, the ShapeMix, the speed in units per second and the
+ * BroadphaseType. */
+static void BM_WorldStep(benchmark::State &p_state)
+{
+	int count = p_state.range(0);
+	float density = p_state.range(1) / 100.0f;
+	cdl::World world;
+	cdl::SpatialHashGrid grid(1);
+	cdl::SweepAndPrune sweepAndPrune;
+	cdl::DynamicAABBTree tree;
+
+	createScene(world, count, density, (ShapeMix) p_state.range(2), p_state.range(3));
+	if(p_state.range(4) == BROADPHASE_GRID)
+		world.setBroadphase(&grid);
+	else if(p_state.range(4) == BROADPHASE_SWEEP_AND_PRUNE)
+		world.setBroadphase(&sweepAndPrune);
+	else if(p_state.range(4) == BROADPHASE_TREE)
+		world.setBroadphase(&tree);
+
+	// first step builds the broadphase from scratch, which is not measured
+	world.step(1.0f / 60, 1);
+	for(auto _ : p_state)
+		world.step(1.0f / 60, 1);
+
+	p_state.SetItemsProcessed(p_state.iterations() * count);
+	p_state.counters["objects"] = count;
+#ifdef CDL_PROFILING
+	// phases of the last step
+	const cdl::StepStats &stats = world.getStepStats();
+	p_state.counters["broadphaseSec"] = stats.broadphaseSec;
+	p_state.counters["narrowphaseSec"] = stats.narrowphaseSec;
+	p_state.counters["pairsTested"] = stats.pairsTested;
+	p_state.counters["shapeTests"] = stats.shapeTests;
+#endif
+	world.setBroadphase(NULL);
+}
+
+static void worldStepArguments(benchmark::internal::Benchmark *p_benchmark)
+{
+	p_benchmark->ArgNames({ "objects", "density", "mix", "speed", "broadphase" });
+
+	/* scaling with the number of objects, checking all pairs is too slow
+	 * for the largest scenes and so is the insertion sort of the first
+	 * SweepAndPrune step */
+	const int counts[] = { 100, 1000, 10000, 100000 };
+	for(int i = 0; i < 4; ++i) {
+		for(int broadphase = BROADPHASE_NONE; broadphase <= BROADPHASE_TREE; ++broadphase) {
+			if((broadphase == BROADPHASE_NONE || broadphase == BROADPHASE_SWEEP_AND_PRUNE) && counts[i] > 10000)
+				continue;
+			p_benchmark->Args({ counts[i], 20, MIX_BOTH, 1, broadphase });
+		}
+	}
+
+	// density, shapes and speed are varied one at a time around 10k objects
+	for(int broadphase = BROADPHASE_GRID; broadphase <= BROADPHASE_TREE; ++broadphase) {
+		p_benchmark->Args({ 10000, 5, MIX_BOTH, 1, broadphase });
+		p_benchmark->Args({ 10000, 80, MIX_BOTH, 1, broadphase });
+		p_benchmark->Args({ 10000, 20, MIX_CIRCLES, 1, broadphase });
+		p_benchmark->Args({ 10000, 20, MIX_POLYGONS, 1, broadphase });
+		p_benchmark->Args({ 10000, 20, MIX_BOTH, 20, broadphase });
+	}
+}
+BENCHMARK(BM_WorldStep)->Apply(worldStepArguments)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,41 @@
+/* The AABB class represents an axis aligned bounding box in CDL. It is
+ * given by its minimal and maximal corner. A default constructed AABB is
+ * empty and does not overlap anything. AABBs are used to quickly reject
+ * shapes and objects that cannot collide. */
+
+#ifndef CDL_AABB_HPP
+#define CDL_AABB_HPP
+
+#include <cfloat>
+#include "cdl/Vec2.hpp"
+#include "cdl/Circle.hpp"
+#include "cdl/Polygon.hpp"
+
+namespace cdl
+{
+	class AABB
+	{
+	public:
+		Vec2 min;
+		Vec2 max;
+
+		AABB(): min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX) { }
+		AABB(const Vec2 &p_min, const Vec2 &p_max): min(p_min), max(p_max) { }
+		~AABB() { }
+
+		bool isEmpty() const
+		{ return min.x > max.x || min.y > max.y; }
+
+		// touching boxes overlap, because touching shapes collide
+		bool overlaps(const AABB &p_aabb) const
+		{ return min.x <= p_aabb.max.x && p_aabb.min.x <= max.x && min.y <= p_aabb.max.y && p_aabb.min.y <= max.y; }
+
+		void merge(const AABB &p_aabb);
+		void merge(const Vec2 &p_point);
+	};
+
+	AABB boundsOf(const Circle &p_circle);
+	AABB boundsOf(const Polygon &p_polygon);
+}
+
+#endif // CDL_AABB_HPP
@@ -0,0 +1,63 @@
+/* The BatchCollision component of CDL tests one shape against many shapes
+ * of the same kind at once. The shapes are packed into a CircleBatch or a
+ * LineSegmentBatch, which keep each coordinate in its own array, so several
+ * shapes are tested with a single SIMD instruction. AVX is used if CDL is
+ * compiled with it (CMake option CDL_USE_AVX), SSE2 otherwise. Without SSE2
+ * a scalar loop calculates the same results.
+ * Every batch function fills a hit mask with one entry per packed shape and
+ * returns the number of hits. Two batches are tested pair by pair, the mask
+ * then has one row of the size of the second batch for every shape of the
+ * first batch. The hits are the same as those of 'overlapCircles()' and
+ * 'collideLineSegments()'. If a vector for intersection points is given,
+ * the intersection points of all hits are appended to it in order of the
+ * hit mask. */
+
+#ifndef CDL_BATCH_COLLISION_HPP
+#define CDL_BATCH_COLLISION_HPP
+
+#include <vector>
+#include "cdl/Circle.hpp"
+#include "cdl/Line.hpp"
+
+namespace cdl
+{
+	class CircleBatch
+	{
+	public:
+		std::vector<float> midX;
+		std::vector<float> midY;
+		std::vector<float> radius;
+
+		CircleBatch() { }
+		~CircleBatch() { }
+
+		void add(const Circle &p_circle);
+		void clear();
+		unsigned int size() const;
+		Circle get(const unsigned int p_index) const;
+	};
+
+	class LineSegmentBatch
+	{
+	public:
+		std::vector<float> x1;
+		std::vector<float> y1;
+		std::vector<float> x2;
+		std::vector<float> y2;
+
+		LineSegmentBatch() { }
+		~LineSegmentBatch() { }
+
+		void add(const Line &p_lineSegment);
+		void clear();
+		unsigned int size() const;
+		Line get(const unsigned int p_index) const;
+	};
+
+	unsigned int overlapCircleBatch(const Circle &p_circle, const CircleBatch &p_batch, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints = NULL);
+	unsigned int overlapCircleBatch(const CircleBatch &p_batch1, const CircleBatch &p_batch2, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints = NULL);
+	unsigned int collideLineSegmentBatch(const Line &p_lineSegment, const LineSegmentBatch &p_batch, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints = NULL);
+	unsigned int collideLineSegmentBatch(const LineSegmentBatch &p_batch1, const LineSegmentBatch &p_batch2, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints = NULL);
+}
+
+#endif // CDL_BATCH_COLLISION_HPP
@@ -0,0 +1,55 @@
+/* The Broadphase Interface is used by the World to find pairs of
+ * CollisionObjects that may collide. Only these candidate pairs are
+ * passed on to the exact collision tests.
+ * An implementation can be set in the World with
+ * 'setBroadphase(Broadphase *p_broadphase)'. The World notifies it about
+ * added and removed objects and calls 'findPairs()' once per iteration.
+ * The bounds to use for 'p_objects[i]' are 'p_bounds[i]', which are not
+ * always the bounds of the object, e.g. the swept bounds in continuous
+ * mode. Every object is at index 'getIndex()' of both arrays.
+ * The pairs have to contain the object with the lower ID as objectA and
+ * have to be sorted ascending by the IDs of objectA and objectB. This is
+ * the order in which the brute force loop visits all pairs, so every
+ * Broadphase triggers the CollisionHandler in the same order.
+ * 'query()' returns every object whose bounds from the last 'findPairs()'
+ * overlap the given bounds. Each object is returned once, in any order.
+ * If no Broadphase is set the World checks every pair of objects. */
+
+#ifndef CDL_BROADPHASE_HPP
+#define CDL_BROADPHASE_HPP
+
+#include <vector>
+#include "cdl/CollisionObject.hpp"
+
+namespace cdl
+{
+	class CollisionPair
+	{
+	public:
+		CollisionObject *objectA;
+		CollisionObject *objectB;
+
+		CollisionPair(): objectA(NULL), objectB(NULL) { }
+		CollisionPair(CollisionObject *p_objectA, CollisionObject *p_objectB)
+		:objectA(p_objectA), objectB(p_objectB) { }
+		~CollisionPair() { }
+	};
+
+	bool operator<(CollisionPair const& p_pair1, CollisionPair const& p_pair2);
+	void sortPairs(std::vector<CollisionPair> &p_pairs);
+
+	class Broadphase
+	{
+	public:
+		Broadphase() { }
+		virtual ~Broadphase() { }
+
+		virtual void addObject(CollisionObject*) { }
+		virtual void removeObject(CollisionObject*) { }
+		virtual void clear() { }
+		virtual void findPairs(const std::vector<CollisionObject*> &p_objects, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs) = 0;
+		virtual void query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects) = 0;
+	};
+}
+
+#endif // CDL_BROADPHASE_HPP
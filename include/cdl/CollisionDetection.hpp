@@ -1,7 +1,14 @@
 /* The CollisionDetection component of CDL provides functions to calculate collisions
  * between various 2 dimensional objects.
  * Every function returns true if a collision happened. In this case the intersection points
- * are stored in the vector given as last argument. */
+ * are appended to the vector given as last argument. Duplicate points, e.g. at
+ * corners shared by two edges, are removed within a small tolerance. Apart from
+ * growing that vector the collide functions do not allocate memory, so a vector
+ * that is reused keeps its capacity.
+ * The overlap functions only check if two shapes overlap. They return as
+ * soon as this is clear, do not calculate any intersection points and do not
+ * allocate memory. Unlike the collide functions they also detect shapes that
+ * lie completely inside another shape. */
  
 #ifndef CDL_COLLISION_DETECTION_HPP
 #define CDL_COLLISION_DETECTION_HPP
@@ -23,6 +30,19 @@ namespace cdl
 	bool collideLinePolygon(const Line &p_line, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints);
 	bool collideLineSegmentPolygon(const Line &p_line, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints);
 	bool collideCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints);
+	
+	bool overlapPointCircle(const Vec2 &p_point, const Circle &p_circle);
+	bool overlapPointPolygon(const Vec2 &p_point, const Polygon &p_polygon);
+	bool overlapCircles(const Circle &p_circle1, const Circle &p_circle2);
+	bool overlapLines(const Line &p_line1, const Line &p_line2);
+	bool overlapLineSegments(const Line &p_line1, const Line &p_line2);
+	bool overlapLineLineSegment(const Line &p_line, const Line &p_lineSegment);
+	bool overlapLineCircle(const Line &p_line, const Circle &p_circle);
+	bool overlapLineSegmentCircle(const Line &p_line, const Circle &p_circle);
+	bool overlapPolygons(const Polygon &p_polygon1, const Polygon &p_polygon2);
+	bool overlapLinePolygon(const Line &p_line, const Polygon &p_polygon);
+	bool overlapLineSegmentPolygon(const Line &p_line, const Polygon &p_polygon);
+	bool overlapCirclePolygon(const Circle &p_circle, const Polygon &p_polygon);
 }
 
 #endif // CDL_COLLISION_DETECTION_HPP
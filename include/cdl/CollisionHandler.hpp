@@ -4,7 +4,20 @@
  * in the World class.
  * If a collision happens the function 'collide(CollisionEvent &p_event)'
  * is triggered. The given CollisionEvent contains the two objects that
- * are part of the collision and the intersection points. */
+ * are part of the collision and the intersection points. Its time is the
+ * time in seconds after the beginning of the iteration at which the
+ * collision happened. Without continuous collision detection collisions
+ * are only found at the end of an iteration.
+ * If the World defers its events, all collisions of an iteration are
+ * collected in a CollisionEventBuffer and passed to
+ * 'collideBatch(CollisionEventBuffer &p_events)' at once. By default it
+ * calls 'collide()' for every event in the buffer, a handler can override
+ * it to process all events in one go.
+ * If the World keeps a PairCache it also reports when contacts change.
+ * 'beginContact()' is called when two objects touch for the first time,
+ * 'persistContact()' while they keep touching and 'endContact()' when they
+ * separate again. The events of 'endContact()' have no intersection points.
+ * By default these functions do nothing. */
  
 #ifndef CDL_COLLISION_HANDLER_HPP
 #define CDL_COLLISION_HANDLER_HPP
@@ -20,27 +33,78 @@ namespace cdl
 		const std::vector<Vec2> &intersectionPoints;
 		CollisionObject *objectA;
 		CollisionObject *objectB;
+		float time;
 		
 	public:
-		CollisionEvent(const std::vector<Vec2> &p_intersectionPoints, CollisionObject *p_objectA, CollisionObject *p_objectB)
-		:intersectionPoints(p_intersectionPoints), objectA(p_objectA), objectB(p_objectB) { }
+		CollisionEvent(const std::vector<Vec2> &p_intersectionPoints, CollisionObject *p_objectA, CollisionObject *p_objectB, const float p_time = 0)
+		:intersectionPoints(p_intersectionPoints), objectA(p_objectA), objectB(p_objectB), time(p_time) { }
 		~CollisionEvent() { }
 		
 		CollisionObject* getObjectA()
 		{return objectA;}
 		CollisionObject* getObjectB()
 		{return objectB;}
+		float getTime() const
+		{return time;}
 		
 		const std::vector<Vec2>& getIntersectionPoints()
 		{return intersectionPoints;}
 	};
 	
+	// keeps the events in one array and their points in another, memory is reused after 'clear()'
+	class CollisionEventBuffer
+	{
+	private:
+		class Entry
+		{
+		public:
+			CollisionObject *objectA;
+			CollisionObject *objectB;
+			unsigned int pointStart;
+			unsigned int pointCount;
+			float time;
+		};
+		
+		std::vector<Entry> entryVec;
+		std::vector<Vec2> pointVec;
+	public:
+		CollisionEventBuffer() { }
+		~CollisionEventBuffer() { }
+		
+		void add(CollisionObject *p_objectA, CollisionObject *p_objectB, const std::vector<Vec2> &p_intersectionPoints, const float p_time);
+		void clear();
+		
+		unsigned int size() const
+		{return entryVec.size();}
+		bool empty() const
+		{return entryVec.empty();}
+		
+		CollisionObject* getObjectA(const unsigned int p_index)
+		{return entryVec[p_index].objectA;}
+		CollisionObject* getObjectB(const unsigned int p_index)
+		{return entryVec[p_index].objectB;}
+		float getTime(const unsigned int p_index) const
+		{return entryVec[p_index].time;}
+		
+		unsigned int getIntersectionPointCount(const unsigned int p_index) const
+		{return entryVec[p_index].pointCount;}
+		const Vec2* getIntersectionPoints(const unsigned int p_index) const
+		{return pointVec.data() + entryVec[p_index].pointStart;}
+	};
+	
 	class CollisionHandler
 	{
+	private:
+		std::vector<Vec2> batchPointVec;
 	public:
 		CollisionHandler() { }
 		virtual ~CollisionHandler() { }
 		virtual void collide(CollisionEvent &p_event) = 0;
+		virtual void collideBatch(CollisionEventBuffer &p_events);
+		
+		virtual void beginContact(CollisionEvent&) { }
+		virtual void persistContact(CollisionEvent&) { }
+		virtual void endContact(CollisionEvent&) { }
 	};
 }
 
@@ -1,9 +1,32 @@
 /* The CollisionObject is the common representation of a 2 dimensional
  * object in CDL. It consists of a list of polygons and a list of circles.
  * The positions of the circles and polygons are relative to the position
- * of the object.
+ * of the object. The direction rotates them counter-clockwise around the
+ * position of the object, the shapes themselves are never changed.
  * The userData field can be used to store any additional data in the
- * CollisionObject. */
+ * CollisionObject.
+ * Every CollisionObject created by a World gets a unique ID. IDs increase
+ * in order of creation. The index is the position of the object in the
+ * arrays of its World, it changes when objects before it are destroyed.
+ * The object caches its shapes in world space, which are used for
+ * collision detection. 'updateWorldShapes()' only recalculates them if the
+ * position or the direction changed since the last call. The sine and
+ * cosine of the direction are calculated once when it is set. The World calls
+ * it once per iteration after moving the objects. Together with the shapes
+ * the bounds of every shape and of the whole object are cached.
+ * The world shapes stay in the object instead of packed buffers of the
+ * World, because every narrowphase and query takes a Polygon with its own
+ * corners. The corners of a polygon are contiguous and pooled objects keep
+ * the memory of their world shapes, so steps do not allocate.
+ * Objects of a World live in its ObjectPool. 'getHandle()' returns an
+ * ObjectHandle, which stays valid as long as the object exists. The World
+ * resolves it with 'getObject(const ObjectHandle &p_handle)' and returns
+ * NULL once the object was destroyed, even if its memory was reused.
+ * Static objects are never moved by the World, e.g. the geometry of a
+ * level. If the World lets objects sleep, objects whose linearVelocity
+ * stays 0 fall asleep after some iterations. Pairs of static and sleeping
+ * objects are not checked. Objects wake up if their velocity or position
+ * is changed, or if a moving object touches their bounds. */
 
 #ifndef CDL_COLLISION_OBJECT_HPP
 #define CDL_COLLISION_OBJECT_HPP
@@ -11,34 +34,95 @@
 #include <vector>
 #include "cdl/Polygon.hpp"
 #include "cdl/Circle.hpp"
+#include "cdl/AABB.hpp"
 
 namespace cdl
 {
+	class World;
+	class ObjectPool;
+	
+	class ObjectHandle
+	{
+	public:
+		unsigned int slot;
+		unsigned int generation;
+		
+		ObjectHandle(): slot(0), generation(0) { }
+		ObjectHandle(const unsigned int p_slot, const unsigned int p_generation)
+		:slot(p_slot), generation(p_generation) { }
+		~ObjectHandle() { }
+	};
+	
+	bool operator==(ObjectHandle const& p_handle1, ObjectHandle const& p_handle2);
+	bool operator!=(ObjectHandle const& p_handle1, ObjectHandle const& p_handle2);
+	
 	class CollisionObject
 	{
+		friend class World;
+		friend class ObjectPool;
 	private:
 		std::vector<Polygon> polygonVec;
 		std::vector<Circle> circleVec;
+		std::vector<bool> polygonConvexVec;
 		float direction;
+		float rotationCos;
+		float rotationSin;
+		unsigned int id;
+		unsigned int index;
+		unsigned int substeps;
+		bool staticBody;
+		bool sleeping;
+		unsigned int idleIterations;
+		bool inStaticTree;
+		ObjectHandle handle;
 		
-		void rotatePoint(Vec2 &p_point, float p_tanVal);
+		std::vector<Polygon> worldPolygonVec;
+		std::vector<Circle> worldCircleVec;
+		std::vector<AABB> worldPolygonBoundsVec;
+		std::vector<AABB> worldCircleBoundsVec;
+		AABB worldBounds;
+		Vec2 worldPosition;
+		bool worldShapesDirty;
+		
+		void updateConvexity();
+		
+		// only used by the ObjectPool, which reuses objects with their memory
+		CollisionObject(): direction(0), rotationCos(1), rotationSin(0), id(0), index(0), substeps(1), staticBody(false), sleeping(false), idleIterations(0), inStaticTree(false), worldShapesDirty(true), userData(NULL) { }
+		void reset(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles);
 	public:
 		void *userData;
 		Vec2 position;
 		Vec2 linearVelocity;
 		
 		CollisionObject(const std::vector<Polygon> &p_polygons)
-		:polygonVec(p_polygons), circleVec() { }
+		:polygonVec(p_polygons), circleVec(), direction(0), rotationCos(1), rotationSin(0), id(0), index(0), substeps(1), staticBody(false), sleeping(false), idleIterations(0), inStaticTree(false), worldShapesDirty(true) { updateConvexity(); }
 		CollisionObject(const std::vector<Circle> &p_circles)
-		:polygonVec(), circleVec(p_circles) { }
+		:polygonVec(), circleVec(p_circles), direction(0), rotationCos(1), rotationSin(0), id(0), index(0), substeps(1), staticBody(false), sleeping(false), idleIterations(0), inStaticTree(false), worldShapesDirty(true) { updateConvexity(); }
 		CollisionObject(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles)
-		:polygonVec(p_polygons), circleVec(p_circles) { }
+		:polygonVec(p_polygons), circleVec(p_circles), direction(0), rotationCos(1), rotationSin(0), id(0), index(0), substeps(1), staticBody(false), sleeping(false), idleIterations(0), inStaticTree(false), worldShapesDirty(true) { updateConvexity(); }
 		~CollisionObject() { }
 		
 		void setDirection(float p_radian);
 		float getDirection() const;
+		unsigned int getID() const;
+		unsigned int getIndex() const;
+		ObjectHandle getHandle() const;
+		const AABB& bounds() const;
 		const std::vector<Polygon>& polygons() const;
 		const std::vector<Circle>& circles() const;
+		bool isPolygonConvex(const unsigned int p_index) const;
+		
+		void setStatic(const bool p_static);
+		bool isStatic() const;
+		bool isSleeping() const;
+		bool isIdle() const;
+		void wakeUp();
+		
+		void updateWorldShapes();
+		const std::vector<Polygon>& worldPolygons() const;
+		const std::vector<Circle>& worldCircles() const;
+		const std::vector<AABB>& worldPolygonBounds() const;
+		const std::vector<AABB>& worldCircleBounds() const;
 	};
 }
 
@@ -0,0 +1,27 @@
+/* The ContactManifold describes the contact of two overlapping shapes.
+ * The normal points from the first shape towards the second shape and has
+ * length 1. The penetration is the distance the shapes have to be moved
+ * apart along the normal to only touch each other. The contact area is
+ * described by up to two contact points. */
+
+#ifndef CDL_CONTACT_MANIFOLD_HPP
+#define CDL_CONTACT_MANIFOLD_HPP
+
+#include "cdl/Vec2.hpp"
+
+namespace cdl
+{
+	class ContactManifold
+	{
+	public:
+		Vec2 normal;
+		float penetration;
+		Vec2 points[2];
+		unsigned int pointCount;
+
+		ContactManifold(): normal(), penetration(0), pointCount(0) { }
+		~ContactManifold() { }
+	};
+}
+
+#endif // CDL_CONTACT_MANIFOLD_HPP
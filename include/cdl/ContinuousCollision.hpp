@@ -0,0 +1,30 @@
+/* The ContinuousCollision component of CDL calculates the time of impact
+ * of two shapes, which move with a constant velocity. Instead of checking
+ * the shapes at the end of a timestep it finds the first moment at which
+ * they touch, so fast shapes cannot tunnel through each other.
+ * Every function returns true if the shapes touch within the given time
+ * in seconds. In this case the time of impact is returned in 'p_time'. It
+ * is 0 if the shapes already overlap at the beginning.
+ * Circles are solved exactly. Other convex shapes are moved towards each
+ * other by conservative advancement, using the distance from GJK, until
+ * they are closer than a small tolerance.
+ * 'sweepObjects()' checks all shapes of two CollisionObjects with their
+ * linearVelocity, starting at their world shapes. Concave polygons are
+ * handled as their edges. It also returns the point where the objects
+ * touch first. */
+
+#ifndef CDL_CONTINUOUS_COLLISION_HPP
+#define CDL_CONTINUOUS_COLLISION_HPP
+
+#include "cdl/Circle.hpp"
+#include "cdl/CollisionObject.hpp"
+#include "cdl/GJK.hpp"
+
+namespace cdl
+{
+	bool sweepCircles(const Circle &p_circle1, const Vec2 &p_velocity1, const Circle &p_circle2, const Vec2 &p_velocity2, const float p_sec, float &p_time);
+	bool sweepConvexShapes(const ConvexShape &p_shapeA, const Vec2 &p_velocityA, const ConvexShape &p_shapeB, const Vec2 &p_velocityB, const float p_sec, float &p_time);
+	bool sweepObjects(const CollisionObject &p_objectA, const CollisionObject &p_objectB, const float p_sec, float &p_time, Vec2 &p_point);
+}
+
+#endif // CDL_CONTINUOUS_COLLISION_HPP
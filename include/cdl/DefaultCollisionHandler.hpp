@@ -1,6 +1,7 @@
 /* The DefaultCollisionHandler is the standard Handler for World
  * objects in CDL. If a collision happens it sets the linearVelocity
- * of the two objects that take part in it to 0. */
+ * of the two objects that take part in it to 0. Batches of deferred events
+ * are handled in one loop without calling 'collide()' for each of them. */
 
 #ifndef CDL_DEFAULT_COLLISION_HANDLER_HPP
 #define CDL_DEFAULT_COLLISION_HANDLER_HPP
@@ -14,6 +15,14 @@ namespace cdl
 	public:
 		void collide(CollisionEvent &p_event)
 		{ p_event.getObjectA()->linearVelocity.set(0,0); p_event.getObjectB()->linearVelocity.set(0,0); }
+		
+		void collideBatch(CollisionEventBuffer &p_events)
+		{
+			for(unsigned int i = 0; i < p_events.size(); ++i) {
+				p_events.getObjectA(i)->linearVelocity.set(0,0);
+				p_events.getObjectB(i)->linearVelocity.set(0,0);
+			}
+		}
 	};
 }
 
@@ -0,0 +1,80 @@
+/* The DynamicAABBTree is a Broadphase that keeps the bounds of all objects
+ * in a balanced binary tree. Inner nodes bound both of their children, so
+ * a query only descends into the parts of the plane it touches. The tree
+ * adapts to objects of any size, which makes it a good choice if they
+ * differ too much for a single cell size of a SpatialHashGrid.
+ * Objects are inserted and removed in logarithmic time. Each leaf stores
+ * the bounds of its object enlarged by a margin. As long as the object
+ * stays inside these fat bounds its leaf is not touched, otherwise it is
+ * removed and inserted again. A larger margin means fewer updates of
+ * moving objects but more candidates per query.
+ * Pairs and query results are only reported if the real bounds of the
+ * objects overlap. */
+
+#ifndef CDL_DYNAMIC_AABB_TREE_HPP
+#define CDL_DYNAMIC_AABB_TREE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include "cdl/Broadphase.hpp"
+
+namespace cdl
+{
+	class DynamicAABBTree : public Broadphase
+	{
+	private:
+		class Node
+		{
+		public:
+			AABB bounds;
+			int parent;
+			int left;
+			int right;
+			int height;
+			// proxy of a leaf, the next free node of a free one
+			int proxy;
+
+			bool isLeaf() const
+			{ return left < 0; }
+		};
+
+		class Proxy
+		{
+		public:
+			CollisionObject *object;
+			AABB bounds;
+			int leaf;
+		};
+
+		float margin;
+		int root;
+		int freeNode;
+		std::vector<Node> nodeVec;
+		std::vector<Proxy> proxyVec;
+		std::unordered_map<CollisionObject*, unsigned int> proxyMap;
+		std::vector<int> stackVec;
+
+		int allocateNode();
+		void freeNodeAt(const int p_node);
+		void insertLeaf(const int p_leaf);
+		void removeLeaf(const int p_leaf);
+		int balance(const int p_node);
+		void refit(int p_node);
+		void updateProxy(const unsigned int p_proxy, const AABB &p_bounds);
+	public:
+		DynamicAABBTree(const float p_margin = 0.1f): margin(p_margin), root(-1), freeNode(-1) { }
+		~DynamicAABBTree() { }
+
+		void setMargin(const float p_margin);
+		float getMargin() const;
+		int getHeight() const;
+
+		void addObject(CollisionObject *p_object);
+		void removeObject(CollisionObject *p_object);
+		void clear();
+		void findPairs(const std::vector<CollisionObject*> &p_objects, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs);
+		void query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects);
+	};
+}
+
+#endif // CDL_DYNAMIC_AABB_TREE_HPP
@@ -0,0 +1,61 @@
+/* The GJK component of CDL calculates distances and collisions between
+ * arbitrary convex shapes. It only needs a support function for each shape,
+ * which returns the point of the shape furthest in a given direction. The
+ * ConvexShape provides it for circles, convex polygons and line segments.
+ * Circles are handled as their mid with a radius, which is added after the
+ * distance of the mids was found.
+ * A ConvexShape can be moved by an offset with 'setOffset()' without
+ * changing the shape it was created from.
+ * 'gjkDistance()' returns the distance between two shapes and their closest
+ * points. The distance is 0 if the shapes overlap. 'gjkCollide()'
+ * additionally calculates the penetration of overlapping shapes with EPA
+ * and returns it in a ContactManifold with one contact point. Both
+ * algorithms stop after a fixed number of iterations.
+ * The distance between two CollisionObjects is the smallest distance of all
+ * their shapes in world space. Concave polygons are handled as their edges,
+ * so the distance to objects inside of them is the distance to their
+ * edges. */
+
+#ifndef CDL_GJK_HPP
+#define CDL_GJK_HPP
+
+#include "cdl/Polygon.hpp"
+#include "cdl/Circle.hpp"
+#include "cdl/Line.hpp"
+#include "cdl/ContactManifold.hpp"
+#include "cdl/CollisionObject.hpp"
+
+namespace cdl
+{
+	class ConvexShape
+	{
+	private:
+		Vec2 localVertices[2];
+		const Vec2 *vertices;
+		unsigned int vertexCount;
+		float radius;
+		Vec2 offset;
+	public:
+		ConvexShape(const Circle &p_circle);
+		ConvexShape(const Polygon &p_polygon);
+		ConvexShape(const Line &p_lineSegment);
+		ConvexShape(const ConvexShape &p_shape);
+		~ConvexShape() { }
+
+		ConvexShape& operator=(const ConvexShape &p_shape);
+
+		Vec2 support(const Vec2 &p_direction) const;
+		Vec2 getVertex(const unsigned int p_index) const;
+		unsigned int getVertexCount() const;
+		float getRadius() const;
+		void setOffset(const Vec2 &p_offset);
+		const Vec2& getOffset() const;
+	};
+
+	float gjkDistance(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, Vec2 &p_pointA, Vec2 &p_pointB);
+	float gjkDistance(const CollisionObject &p_objectA, const CollisionObject &p_objectB, Vec2 &p_pointA, Vec2 &p_pointB);
+	bool gjkIntersect(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB);
+	bool gjkCollide(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, ContactManifold &p_manifold);
+}
+
+#endif // CDL_GJK_HPP
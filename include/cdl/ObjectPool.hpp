@@ -0,0 +1,48 @@
+/* The ObjectPool creates and destroys the CollisionObjects of a World.
+ * Objects are allocated in blocks, which are never moved or freed before
+ * the pool is destroyed. Destroyed objects are put on a free list and are
+ * reused by the next 'create()', together with the memory of their shapes.
+ * Creating and destroying an object therefore takes constant time and
+ * usually does not allocate any memory.
+ * Every slot of the pool has a generation, which is increased whenever its
+ * object is destroyed. An ObjectHandle only resolves to an object if its
+ * generation matches the one of the slot.
+ * 'clear()' destroys all objects at once and keeps all blocks. */
+
+#ifndef CDL_OBJECT_POOL_HPP
+#define CDL_OBJECT_POOL_HPP
+
+#include <vector>
+#include "cdl/CollisionObject.hpp"
+
+namespace cdl
+{
+	class ObjectPool
+	{
+	private:
+		std::vector<CollisionObject*> blockVec;
+		std::vector<CollisionObject*> slotVec;
+		std::vector<unsigned int> generationVec;
+		std::vector<unsigned int> freeSlotVec;
+		unsigned int objectCount;
+		
+		void addBlock();
+		bool isUsed(const unsigned int p_slot) const;
+		
+		ObjectPool(const ObjectPool &p_pool);
+		ObjectPool& operator=(const ObjectPool &p_pool);
+	public:
+		ObjectPool(): objectCount(0) { }
+		~ObjectPool();
+		
+		CollisionObject* create(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles);
+		void destroy(CollisionObject *p_object);
+		void clear();
+		
+		bool contains(const CollisionObject *p_object) const;
+		CollisionObject* get(const ObjectHandle &p_handle) const;
+		unsigned int size() const;
+	};
+}
+
+#endif // CDL_OBJECT_POOL_HPP
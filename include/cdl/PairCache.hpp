@@ -0,0 +1,51 @@
+/* The PairCache keeps the state of pairs of CollisionObjects between
+ * iterations. Pairs are looked up by the IDs of their objects, which are
+ * never reused. An entry remembers whether the objects touched when they
+ * were checked last, and an axis that separated them if they did not.
+ * Every iteration the World visits the pairs it checks. After the
+ * iteration 'findUnvisited()' returns the entries that were not visited,
+ * the World removes the ones that ended and keeps the ones it skipped. */
+
+#ifndef CDL_PAIR_CACHE_HPP
+#define CDL_PAIR_CACHE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include "cdl/CollisionObject.hpp"
+
+namespace cdl
+{
+	class PairCache
+	{
+	public:
+		class Entry
+		{
+		public:
+			unsigned long long key;
+			ObjectHandle handleA;
+			ObjectHandle handleB;
+			unsigned int stamp;
+			bool touching;
+			bool hasAxis;
+			Vec2 axis;
+
+			Entry(): key(0), stamp(0), touching(false), hasAxis(false) { }
+			~Entry() { }
+		};
+	private:
+		std::unordered_map<unsigned long long, Entry> entryMap;
+		unsigned int stamp;
+	public:
+		PairCache(): stamp(0) { }
+		~PairCache() { }
+
+		void nextIteration();
+		Entry& visit(CollisionObject *p_objectA, CollisionObject *p_objectB);
+		void findUnvisited(std::vector<Entry> &p_unvisited) const;
+		void remove(const Entry &p_entry);
+		void clear();
+		unsigned int size() const;
+	};
+}
+
+#endif // CDL_PAIR_CACHE_HPP
@@ -0,0 +1,45 @@
+/* The Raycast component of CDL finds where a ray or a moving shape hits
+ * other shapes first. A ray is given as Line from its start to its end.
+ * Hits are described by the fraction of the way to the end at which the
+ * ray hits, the point of the hit and the normal of the surface, which has
+ * length 1 and points towards the start of the ray.
+ * A ray that starts inside of a shape hits it at fraction 0, the normal
+ * then points against the ray.
+ * Every function returns true if a hit was found, the objects functions
+ * return the closest hit of all shapes of the object in world space.
+ * 'castShape()' moves a convex shape along a translation and uses
+ * conservative advancement to find the first contact. The normal points
+ * from the target towards the moving shape. Concave polygons of objects
+ * are handled as their edges. */
+
+#ifndef CDL_RAYCAST_HPP
+#define CDL_RAYCAST_HPP
+
+#include "cdl/Line.hpp"
+#include "cdl/Circle.hpp"
+#include "cdl/Polygon.hpp"
+#include "cdl/CollisionObject.hpp"
+#include "cdl/GJK.hpp"
+
+namespace cdl
+{
+	class RaycastHit
+	{
+	public:
+		CollisionObject *object;
+		Vec2 point;
+		Vec2 normal;
+		float fraction;
+
+		RaycastHit(): object(NULL), point(), normal(), fraction(1) { }
+		~RaycastHit() { }
+	};
+
+	bool raycastCircle(const Line &p_ray, const Circle &p_circle, float &p_fraction, Vec2 &p_normal);
+	bool raycastPolygon(const Line &p_ray, const Polygon &p_polygon, float &p_fraction, Vec2 &p_normal);
+	bool raycastObject(const Line &p_ray, const CollisionObject &p_object, RaycastHit &p_hit);
+	bool castShape(const ConvexShape &p_shape, const Vec2 &p_translation, const ConvexShape &p_target, float &p_fraction, Vec2 &p_point, Vec2 &p_normal);
+	bool castShapeObject(const ConvexShape &p_shape, const Vec2 &p_translation, const CollisionObject &p_object, RaycastHit &p_hit);
+}
+
+#endif // CDL_RAYCAST_HPP
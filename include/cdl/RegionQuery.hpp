@@ -0,0 +1,32 @@
+/* The RegionQuery component of CDL checks which CollisionObjects overlap
+ * an area. An area is a circle or a polygon, the polygon may be concave.
+ * Objects inside of the area and areas inside of an object count as
+ * overlapping. The shapes of the objects in world space are used.
+ * A QueryCallback receives the objects found by 'World::queryRegion()'.
+ * Returning false from 'reportObject()' stops the query. */
+
+#ifndef CDL_REGION_QUERY_HPP
+#define CDL_REGION_QUERY_HPP
+
+#include "cdl/Circle.hpp"
+#include "cdl/Polygon.hpp"
+#include "cdl/AABB.hpp"
+#include "cdl/CollisionObject.hpp"
+
+namespace cdl
+{
+	class QueryCallback
+	{
+	public:
+		QueryCallback() { }
+		virtual ~QueryCallback() { }
+
+		virtual bool reportObject(CollisionObject *p_object) = 0;
+	};
+
+	Polygon polygonOf(const AABB &p_bounds);
+	bool overlapObjectCircle(const CollisionObject &p_object, const Circle &p_circle);
+	bool overlapObjectPolygon(const CollisionObject &p_object, const Polygon &p_polygon);
+}
+
+#endif // CDL_REGION_QUERY_HPP
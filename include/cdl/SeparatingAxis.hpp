@@ -0,0 +1,28 @@
+/* The SeparatingAxis component of CDL provides collision functions for convex
+ * shapes based on the Separating Axis Theorem. Two convex shapes do not
+ * collide if there is an axis on which their projections do not overlap. For
+ * polygons only the edge normals have to be checked.
+ * Every function returns true if the shapes collide. In this case the contact
+ * is described by the ContactManifold given as last argument. Unlike the
+ * functions in CollisionDetection also shapes inside of each other are
+ * detected.
+ * The polygons have to be convex, which can be checked with 'isConvex()'.
+ * The corners can be given clockwise or counter-clockwise. */
+
+#ifndef CDL_SEPARATING_AXIS_HPP
+#define CDL_SEPARATING_AXIS_HPP
+
+#include "cdl/Polygon.hpp"
+#include "cdl/Circle.hpp"
+#include "cdl/ContactManifold.hpp"
+
+namespace cdl
+{
+	bool isConvex(const Polygon &p_polygon);
+
+	bool collideCircles(const Circle &p_circle1, const Circle &p_circle2, ContactManifold &p_manifold);
+	bool collideCircleConvexPolygon(const Circle &p_circle, const Polygon &p_polygon, ContactManifold &p_manifold);
+	bool collideConvexPolygons(const Polygon &p_polygon1, const Polygon &p_polygon2, ContactManifold &p_manifold);
+}
+
+#endif // CDL_SEPARATING_AXIS_HPP
@@ -0,0 +1,51 @@
+/* The SpatialHashGrid is a Broadphase that divides the plane into square
+ * cells of a configurable size. Every object is hashed into all cells its
+ * bounds touch. Only objects sharing a cell and having overlapping bounds
+ * are reported as pair.
+ * The cell size should be about the size of a typical object. If it is
+ * too small big objects get hashed into many cells, if it is too large
+ * many objects share a cell.
+ * Queries look at the cells of the region, or at every object if the
+ * region covers more cells than there are objects. */
+
+#ifndef CDL_SPATIAL_HASH_GRID_HPP
+#define CDL_SPATIAL_HASH_GRID_HPP
+
+#include <vector>
+#include "cdl/Broadphase.hpp"
+
+namespace cdl
+{
+	class SpatialHashGrid : public Broadphase
+	{
+	private:
+		class CellEntry
+		{
+		public:
+			int cellX;
+			int cellY;
+			unsigned int index;
+		};
+
+		float cellSize;
+		std::vector<CollisionObject*> objectVec;
+		std::vector<AABB> boundsVec;
+		std::vector<CellEntry> entryVec;
+		std::vector<CellEntry> bucketEntryVec;
+		std::vector<unsigned int> bucketStartVec;
+
+		int cellCoord(const float p_value) const;
+		unsigned int hashCell(const int p_cellX, const int p_cellY) const;
+	public:
+		SpatialHashGrid(const float p_cellSize = 1.0f): cellSize(p_cellSize) { }
+		~SpatialHashGrid() { }
+
+		void setCellSize(const float p_cellSize);
+		float getCellSize() const;
+
+		void findPairs(const std::vector<CollisionObject*> &p_objects, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs);
+		void query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects);
+	};
+}
+
+#endif // CDL_SPATIAL_HASH_GRID_HPP
@@ -0,0 +1,95 @@
+/* The StaticBVH is a bounding volume hierarchy over the shapes of
+ * CollisionObjects. The World builds one over its static objects and one
+ * over all objects for queries. It is built once and then queried for all objects
+ * whose shapes touch given bounds, which takes logarithmic time in the
+ * number of shapes. An object is returned once for each of its shapes
+ * that touches the bounds.
+ * Every circle and polygon in world space is a primitive of the tree. The
+ * primitives are split with the Surface Area Heuristic, evaluated for a
+ * fixed number of bins along the longest axis of their mids. In 2D the
+ * perimeter of the bounds takes the role of the surface area.
+ * The nodes are stored in one array, the two children of a node are next
+ * to each other. If a ThreadPool is given, the subtrees below the first
+ * levels are built in parallel.
+ * Rays and moving convex shapes can be cast against the tree. Only nodes
+ * that the ray crosses before the closest hit so far are visited. Equally
+ * close hits are resolved towards the object with the lower ID.
+ * The tree keeps pointers to the objects, it has to be rebuilt if one of
+ * them is destroyed. After objects moved, 'refit()' updates the bounds of
+ * all nodes without changing the tree. It returns false if the perimeters
+ * of the nodes grew so much that the tree should be built again. */
+
+#ifndef CDL_STATIC_BVH_HPP
+#define CDL_STATIC_BVH_HPP
+
+#include <vector>
+#include "cdl/CollisionObject.hpp"
+#include "cdl/ThreadPool.hpp"
+#include "cdl/Raycast.hpp"
+
+namespace cdl
+{
+	class StaticBVH
+	{
+	private:
+		class Primitive
+		{
+		public:
+			CollisionObject *object;
+			AABB bounds;
+			Vec2 mid;
+			bool circle;
+			unsigned int shape;
+		};
+
+		// leaves have primitives, inner nodes have their children at 'first' and 'first + 1'
+		class Node
+		{
+		public:
+			AABB bounds;
+			unsigned int first;
+			unsigned int count;
+		};
+
+		class Subtree
+		{
+		public:
+			unsigned int node;
+			unsigned int start;
+			unsigned int count;
+			unsigned int depth;
+			std::vector<Node> nodeVec;
+		};
+
+		class BuildTask;
+
+		std::vector<Primitive> primitiveVec;
+		std::vector<Node> nodeVec;
+		std::vector<Subtree> subtreeVec;
+		float buildCost;
+
+		void addPrimitives(CollisionObject *p_object);
+		void buildNode(std::vector<Node> &p_nodes, const unsigned int p_node, const unsigned int p_start, const unsigned int p_count, const unsigned int p_depth, const unsigned int p_splitDepth);
+		bool splitPrimitives(const unsigned int p_start, const unsigned int p_count, const AABB &p_bounds, unsigned int &p_leftCount);
+		void spliceSubtree(const Subtree &p_subtree);
+		float getCost() const;
+		bool raycastPrimitive(const Primitive &p_primitive, const Line &p_ray, RaycastHit &p_hit) const;
+		bool castShapePrimitive(const Primitive &p_primitive, const ConvexShape &p_shape, const Vec2 &p_translation, RaycastHit &p_hit) const;
+	public:
+		StaticBVH(): buildCost(0) { }
+		~StaticBVH() { }
+
+		void build(const std::vector<CollisionObject*> &p_objects, ThreadPool *p_threadPool = NULL);
+		bool refit();
+		void clear();
+		void query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects) const;
+		bool raycast(const Line &p_ray, RaycastHit &p_hit) const;
+		void raycastAll(const Line &p_ray, std::vector<RaycastHit> &p_hits) const;
+		bool castShape(const ConvexShape &p_shape, const AABB &p_bounds, const Vec2 &p_translation, RaycastHit &p_hit) const;
+
+		bool empty() const;
+		unsigned int getNodeCount() const;
+	};
+}
+
+#endif // CDL_STATIC_BVH_HPP
@@ -0,0 +1,49 @@
+/* The StepStats describe where the time of the last 'World::step()' went.
+ * They are only measured if CDL was compiled with CDL_PROFILING (CMake
+ * option CDL_PROFILING), otherwise all values stay 0 and measuring costs
+ * nothing.
+ * Integration is moving the objects and updating their shapes, the
+ * broadphase is finding candidate pairs, the narrowphase is testing them
+ * and dispatch is calling the CollisionHandler. Times are wall clock
+ * seconds summed over all iterations of the step. With several threads
+ * the narrowphase time is the time until all workers are done.
+ * Considered pairs are pairs with overlapping bounds, tested pairs the
+ * ones that reached the narrowphase. Shape tests are tests of two shapes
+ * whose bounds overlap, intersection points are the points of all
+ * reported collisions. */
+
+#ifndef CDL_STEP_STATS_HPP
+#define CDL_STEP_STATS_HPP
+
+namespace cdl
+{
+	class StepStats
+	{
+	public:
+		float integrationSec;
+		float broadphaseSec;
+		float narrowphaseSec;
+		float dispatchSec;
+		unsigned int pairsConsidered;
+		unsigned int pairsTested;
+		unsigned int shapeTests;
+		unsigned int intersectionPoints;
+
+		StepStats() { clear(); }
+		~StepStats() { }
+
+		void clear()
+		{
+			integrationSec = 0;
+			broadphaseSec = 0;
+			narrowphaseSec = 0;
+			dispatchSec = 0;
+			pairsConsidered = 0;
+			pairsTested = 0;
+			shapeTests = 0;
+			intersectionPoints = 0;
+		}
+	};
+}
+
+#endif // CDL_STEP_STATS_HPP
@@ -0,0 +1,73 @@
+/* The SweepAndPrune is a Broadphase that keeps the minimum and maximum
+ * of every object's bounds on one axis in a sorted list of endpoints.
+ * The list is kept between steps and is only re-sorted with insertion
+ * sort. Objects usually move only a little in one iteration, so the list
+ * is almost sorted and this takes nearly linear time.
+ * Sweeping along the list finds all objects whose intervals overlap. They
+ * are reported as pair if their bounds overlap on the other axis, too.
+ * The axis should be the one along which objects are spread most.
+ * Every proxy knows where its endpoints are, so removing an object only
+ * marks them. They are dropped during the next sort.
+ * Queries walk the endpoints up to the end of the region on the axis, so
+ * they are cheapest for regions near the start of the axis. */
+
+#ifndef CDL_SWEEP_AND_PRUNE_HPP
+#define CDL_SWEEP_AND_PRUNE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include "cdl/Broadphase.hpp"
+
+namespace cdl
+{
+	class SweepAndPrune : public Broadphase
+	{
+	public:
+		enum Axis { AXIS_X, AXIS_Y };
+	private:
+		class Proxy
+		{
+		public:
+			CollisionObject *object;
+			AABB bounds;
+			unsigned int minEndpoint;
+			unsigned int maxEndpoint;
+		};
+
+		class Endpoint
+		{
+		public:
+			float value;
+			unsigned int proxy;
+			bool isMin;
+
+			bool operator<(const Endpoint &p_endpoint) const
+			{ return value < p_endpoint.value || (value == p_endpoint.value && isMin && !p_endpoint.isMin); }
+		};
+
+		Axis axis;
+		std::vector<Proxy> proxyVec;
+		std::unordered_map<CollisionObject*, unsigned int> proxyMap;
+		std::vector<Endpoint> endpointVec;
+		bool endpointsRemoved;
+		std::vector<unsigned int> activeVec;
+
+		void removeEndpoints();
+		void updateEndpoints(const std::vector<AABB> &p_bounds);
+		void sortEndpoints();
+	public:
+		SweepAndPrune(const Axis p_axis = AXIS_X): axis(p_axis), endpointsRemoved(false) { }
+		~SweepAndPrune() { }
+
+		void setAxis(const Axis p_axis);
+		Axis getAxis() const;
+
+		void addObject(CollisionObject *p_object);
+		void removeObject(CollisionObject *p_object);
+		void clear();
+		void findPairs(const std::vector<CollisionObject*> &p_objects, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs);
+		void query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects);
+	};
+}
+
+#endif // CDL_SWEEP_AND_PRUNE_HPP
@@ -0,0 +1,68 @@
+/* The ThreadPool runs the tasks of a job on several threads. A job
+ * consists of a number of tasks, which are given by their index and
+ * executed by a Task implementation. 'run()' blocks until all tasks are
+ * done, the calling thread works on the tasks as worker 0.
+ * Every worker starts with an equal share of the tasks in its own queue.
+ * It takes tasks from the front of its queue. If the queue is empty, it
+ * steals tasks from the back of the queues of the other workers, so
+ * workers with cheap tasks help out those with expensive ones.
+ * The threads are created once and wait for the next job in between. */
+
+#ifndef CDL_THREAD_POOL_HPP
+#define CDL_THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace cdl
+{
+	class ThreadPool
+	{
+	public:
+		class Task
+		{
+		public:
+			Task() { }
+			virtual ~Task() { }
+			virtual void execute(const unsigned int p_worker, const unsigned int p_index) = 0;
+		};
+	private:
+		class WorkQueue
+		{
+		public:
+			std::mutex mutex;
+			unsigned int begin;
+			unsigned int end;
+
+			WorkQueue(): begin(0), end(0) { }
+		};
+
+		std::vector<std::thread> threadVec;
+		std::vector<WorkQueue*> queueVec;
+		std::mutex mutex;
+		std::condition_variable jobCondition;
+		std::condition_variable doneCondition;
+		Task *task;
+		unsigned int job;
+		unsigned int busyWorkers;
+		bool stopping;
+
+		void work(const unsigned int p_worker);
+		void executeTasks(const unsigned int p_worker);
+		bool popTask(const unsigned int p_worker, unsigned int &p_index);
+		bool stealTask(const unsigned int p_worker, unsigned int &p_index);
+
+		ThreadPool(const ThreadPool &p_pool);
+		ThreadPool& operator=(const ThreadPool &p_pool);
+	public:
+		ThreadPool(const unsigned int p_threadCount);
+		~ThreadPool();
+
+		unsigned int getThreadCount() const;
+		void run(const unsigned int p_taskCount, Task &p_task);
+	};
+}
+
+#endif // CDL_THREAD_POOL_HPP
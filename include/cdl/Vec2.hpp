@@ -1,42 +1,82 @@
 #ifndef CDL_VEC2_HPP
 #define CDL_VEC2_HPP
 
+#include <cmath>
 #include <string>
 
 namespace cdl
 {
 	/* This class implements a 2D vector. It provides mathematical operators for adding,
-	 * subtracting and scaling. */
+	 * subtracting and scaling. All math is defined inline in this header, so the compiler
+	 * can fuse it into the surrounding loops. Vec2 is trivially copyable and the pure
+	 * functions are constexpr.
+	 * dot() and cross() return the dot product and the z component of the cross product
+	 * of two vectors, normalize() returns a vector of length 1 (or the zero vector) and
+	 * rotate() turns a vector counterclockwise by an angle or by its cosine and sine. */
 	class Vec2
 	{
 	public:
 		float x;
 		float y;
-	
-		Vec2(): x(0), y(0) { }
-		Vec2(float p_x, float p_y): x(p_x), y(p_y) { }
-		~Vec2() { }
-		
-		void set(const float p_x, const float p_y);
-		float lengthSQ() const;
-		float length() const;
-		Vec2 perpendicular() const;
-		
-		Vec2& operator+=(Vec2 const& p_vec);
-		Vec2& operator-=(Vec2 const& p_vec);
-		Vec2& operator*=(const float p_factor);
-		Vec2& operator/=(const float p_divisor);
-		
+
+		constexpr Vec2(): x(0), y(0) { }
+		constexpr Vec2(float p_x, float p_y): x(p_x), y(p_y) { }
+
+		void set(const float p_x, const float p_y)
+		{ x = p_x; y = p_y; }
+		constexpr float lengthSQ() const
+		{ return x * x + y * y; }
+		float length() const
+		{ return std::sqrt(lengthSQ()); }
+		constexpr Vec2 perpendicular() const
+		{ return Vec2(-y, x); }
+
+		Vec2& operator+=(Vec2 const& p_vec)
+		{ x += p_vec.x; y += p_vec.y; return *this; }
+		Vec2& operator-=(Vec2 const& p_vec)
+		{ x -= p_vec.x; y -= p_vec.y; return *this; }
+		Vec2& operator*=(const float p_factor)
+		{ x *= p_factor; y *= p_factor; return *this; }
+		Vec2& operator/=(const float p_divisor)
+		{ x /= p_divisor; y /= p_divisor; return *this; }
+
 		std::string str() const;
 	};
-	
-	const Vec2 operator+(Vec2 const& p_vec1, Vec2 const& p_vec2);
-	const Vec2 operator-(Vec2 const& p_vec1, Vec2 const& p_vec2);
-	const Vec2 operator*(Vec2 const& p_vec, const float p_factor);
-	const Vec2 operator*(const float p_factor, Vec2 const& p_vec);
-	const Vec2 operator/(Vec2 const& p_vec, const float p_divisor);
-	bool operator==(Vec2 const& p_vec1, Vec2 const& p_vec2);
-	bool operator!=(Vec2 const& p_vec1, Vec2 const& p_vec2);
+
+	constexpr Vec2 operator+(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return Vec2(p_vec1.x + p_vec2.x, p_vec1.y + p_vec2.y); }
+	constexpr Vec2 operator-(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return Vec2(p_vec1.x - p_vec2.x, p_vec1.y - p_vec2.y); }
+	constexpr Vec2 operator-(Vec2 const& p_vec)
+	{ return Vec2(-p_vec.x, -p_vec.y); }
+	constexpr Vec2 operator*(Vec2 const& p_vec, const float p_factor)
+	{ return Vec2(p_vec.x * p_factor, p_vec.y * p_factor); }
+	constexpr Vec2 operator*(const float p_factor, Vec2 const& p_vec)
+	{ return Vec2(p_vec.x * p_factor, p_vec.y * p_factor); }
+	constexpr Vec2 operator/(Vec2 const& p_vec, const float p_divisor)
+	{ return Vec2(p_vec.x / p_divisor, p_vec.y / p_divisor); }
+	constexpr bool operator==(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return p_vec1.x == p_vec2.x && p_vec1.y == p_vec2.y; }
+	constexpr bool operator!=(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return !(p_vec1 == p_vec2); }
+
+	constexpr float dot(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return p_vec1.x * p_vec2.x + p_vec1.y * p_vec2.y; }
+	constexpr float cross(Vec2 const& p_vec1, Vec2 const& p_vec2)
+	{ return p_vec1.x * p_vec2.y - p_vec1.y * p_vec2.x; }
+	constexpr Vec2 rotate(Vec2 const& p_vec, const float p_cos, const float p_sin)
+	{ return Vec2(p_cos * p_vec.x - p_sin * p_vec.y, p_sin * p_vec.x + p_cos * p_vec.y); }
+
+	inline Vec2 rotate(Vec2 const& p_vec, const float p_angle)
+	{
+		return rotate(p_vec, std::cos(p_angle), std::sin(p_angle));
+	}
+
+	inline Vec2 normalize(Vec2 const& p_vec)
+	{
+		float length = p_vec.length();
+		return length > 0 ? p_vec / length : Vec2();
+	}
 }
 
 #endif
@@ -6,39 +6,203 @@
  * whole simulation one timestep ahead. The length of one timestep in seconds
  * is determined by the first argument. The second argument determines how many
  * iterations are done to calculate this timestep. More iterations lead to
- * higher precision but longer execution time. */
+ * higher precision but longer execution time.
+ * The setters below choose how pairs are found and checked, e.g. a
+ * Broadphase, the narrowphase, threads or continuous collision detection.
+ * The collisions found and the order of the events are the same in all
+ * modes. Raycasts and region queries look at the objects at the positions
+ * of the last step. */
 
 #ifndef CDL_WORLD_HPP
 #define CDL_WORLD_HPP
 
-#include <list>
+#include <vector>
+#include <atomic>
 #include "cdl/CollisionObject.hpp"
 #include "cdl/CollisionHandler.hpp"
 #include "cdl/DefaultCollisionHandler.hpp"
+#include "cdl/Broadphase.hpp"
+#include "cdl/ContactManifold.hpp"
+#include "cdl/ObjectPool.hpp"
+#include "cdl/PairCache.hpp"
+#include "cdl/StaticBVH.hpp"
+#include "cdl/Raycast.hpp"
+#include "cdl/RegionQuery.hpp"
+#include "cdl/StepStats.hpp"
 
 namespace cdl
 {
+	class ThreadPool;
+	
 	class World
 	{
+	public:
+		enum Narrowphase { NARROWPHASE_INTERSECTION, NARROWPHASE_OVERLAP, NARROWPHASE_SAT, NARROWPHASE_GJK };
 	private:
-		std::list<CollisionObject*> objects;
+		enum ContactType { CONTACT_BEGIN, CONTACT_PERSIST, CONTACT_END };
+		
+		class PairResult
+		{
+		public:
+			bool collided;
+			unsigned int worker;
+			unsigned int pointStart;
+			unsigned int pointCount;
+		};
+		
+		class SweepResult
+		{
+		public:
+			bool hit;
+			float time;
+			Vec2 point;
+		};
+		
+		class PairTask;
+		class SweepTask;
+		class RaycastTask;
+		class IntersectionTest;
+		class SeparatingAxisTest;
+		class GJKTest;
+		class OverlapTest;
+		
+		// objects are kept in order of creation, their bounds in the same order
+		ObjectPool objectPool;
+		std::vector<CollisionObject*> objectVec;
+		bool objectsRemoved;
+		std::vector<AABB> boundsVec;
 		CollisionHandler *collisionHandler;
 		DefaultCollisionHandler defaultHandler;
+		Broadphase *broadphase;
+		// the broadphase knows the bounds of all objects of the last iteration
+		bool broadphaseCurrent;
+		Narrowphase narrowphase;
+		std::vector<CollisionPair> pairVec;
+		std::vector<Vec2> intersectionPointVec;
+		float iterationSec;
+		bool continuous;
+		std::vector<AABB> sweptBoundsVec;
+		std::vector<float> moveSecVec;
+		std::vector<SweepResult> sweepResultVec;
+		bool adaptiveSubsteps;
+		float maxSubstepMovement;
+		unsigned int iteration;
+		unsigned int iterationCount;
+		unsigned int sleepIterations;
+		bool pairCacheEnabled;
+		PairCache pairCache;
+		CollisionEventBuffer contactBuffer;
+		std::vector<ContactType> contactTypeVec;
+		std::vector<PairCache::Entry> unvisitedPairVec;
+		std::vector<Vec2> contactPointVec;
+		bool deferEvents;
+		CollisionEventBuffer eventBuffer;
+		bool staticTreeEnabled;
+		bool staticTreeDirty;
+		StaticBVH staticTree;
+		std::vector<CollisionObject*> staticObjectVec;
+		std::vector<CollisionObject*> treeHitVec;
+		StaticBVH queryTree;
+		bool queryTreeDirty;
+		bool queryTreeRebuild;
+		std::vector<CollisionObject*> queryObjectVec;
+		StepStats stepStats;
+		// shapes are also tested by the workers
+		mutable std::atomic<unsigned int> shapeTestCount;
+		unsigned int nextID;
+		
+		ThreadPool *threadPool;
+		std::vector<PairResult> pairResultVec;
+		std::vector<std::vector<Vec2> > workerPointVec;
 		
+		void compactObjects();
+		unsigned int chooseSubsteps(const float p_sec, const int p_iterations);
+		bool isDue(const CollisionObject *p_object) const;
+		void updateSleeping(CollisionObject *p_object);
+		void checkStaticTree(const CollisionObject *p_object);
+		bool isPairSkipped(const CollisionObject *p_objectA, const CollisionObject *p_objectB) const;
+		bool preparePair(CollisionObject *p_objectA, CollisionObject *p_objectB);
+		bool isSeparated(CollisionObject *p_objectA, CollisionObject *p_objectB);
+		void reportSeparation(CollisionObject *p_objectA, CollisionObject *p_objectB);
+		void endStalePairs();
+		void dispatchContacts();
 		void moveObjects(const float p_sec);
 		void collideObjects();
+		void sweepObjects(const float p_sec);
+		void buildStaticTree();
+		void addStaticTreePairs(const std::vector<AABB> &p_bounds);
+		void updateQueryTree();
+		void queryRegion(const AABB &p_bounds, const Circle *p_circle, const Polygon *p_polygon, QueryCallback &p_callback);
+		void findCandidatePairs(const std::vector<AABB> &p_bounds);
+		void collidePairs();
+		void collidePairsParallel();
 		void collideObjects(CollisionObject *p_objectA, CollisionObject *p_objectB);
+		void reportCollision(CollisionObject *p_objectA, CollisionObject *p_objectB, const std::vector<Vec2> &p_points, const float p_time);
+		void dispatchEvents();
+		bool testObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const;
+		bool intersectObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const;
+		bool overlapObjects(CollisionObject *p_objectA, CollisionObject *p_objectB) const;
+		bool separateObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const;
+		bool gjkCollideObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const;
+		template<class ShapeTest>
+		bool testShapes(const CollisionObject &p_objectA, const CollisionObject &p_objectB, ShapeTest &p_test, const bool p_firstOnly) const;
+		
+		World(const World &p_world);
+		World& operator=(const World &p_world);
 	public:
-		World() { setDefaultHandler(); }
-		~World() { }
+		World(): objectsRemoved(false), broadphase(NULL), broadphaseCurrent(false), narrowphase(NARROWPHASE_INTERSECTION), iterationSec(0), continuous(false), adaptiveSubsteps(false), maxSubstepMovement(0.5f), iteration(0), iterationCount(0), sleepIterations(0), pairCacheEnabled(false), deferEvents(false), staticTreeEnabled(false), staticTreeDirty(false), queryTreeDirty(true), queryTreeRebuild(true), shapeTestCount(0), nextID(0), threadPool(NULL) { setDefaultHandler(); }
+		~World();
 	
+		// objects live in an ObjectPool, creating and destroying one takes constant time and the gaps
+		// of destroyed objects are closed in one pass before the next iteration. Pointers to destroyed
+		// objects may point to new ones later, their handles do not.
 		CollisionObject* createObject(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles);
 		void destroyObject(CollisionObject* p_object);
 		void destroyAllObjects();
+		CollisionObject* getObject(const ObjectHandle &p_handle) const;
 		void step(const float p_sec, const int p_iterations);
 		
+		// closest hit of a ray, the batch has one hit per ray with a NULL object for misses
+		bool raycast(const Line &p_ray, RaycastHit &p_hit);
+		void raycast(const std::vector<Line> &p_rays, std::vector<RaycastHit> &p_hits);
+		// closest hit of every object along the ray, sorted by fraction
+		void raycastAll(const Line &p_ray, std::vector<RaycastHit> &p_hits);
+		// first object a circle or convex polygon touches while it moves along the translation
+		bool shapeCast(const Circle &p_circle, const Vec2 &p_translation, RaycastHit &p_hit);
+		bool shapeCast(const Polygon &p_polygon, const Vec2 &p_translation, RaycastHit &p_hit);
+		// every object that overlaps the region, in order of their IDs, candidates come from
+		// the broadphase if it saw all objects in the last step and from the query tree otherwise
+		void queryRegion(const AABB &p_bounds, QueryCallback &p_callback);
+		void queryRegion(const Circle &p_circle, QueryCallback &p_callback);
+		void queryRegion(const Polygon &p_polygon, QueryCallback &p_callback);
+		
 		void setCollisionHandler(CollisionHandler *p_collisionHandler);
 		void setDefaultHandler();
+		// only pairs found by the Broadphase are checked, NULL checks all pairs
+		void setBroadphase(Broadphase *p_broadphase);
+		// INTERSECTION calculates all intersection points, OVERLAP none, SAT and GJK
+		// report contact points of convex shapes and intersect concave ones
+		void setNarrowphase(const Narrowphase p_narrowphase);
+		// pairs are tested by a ThreadPool, the handler is still called by this thread
+		void setThreadCount(const unsigned int p_threadCount);
+		unsigned int getThreadCount() const;
+		// collisions of an iteration are passed to 'CollisionHandler::collideBatch()' at once
+		void setDeferredEvents(const bool p_deferred);
+		// pairs are swept along their linearVelocity, objects stop at their first contact and
+		// touching objects stay where they are as long as they move towards each other,
+		// candidates are found with the swept bounds by the broadphase and the static tree
+		void setContinuous(const bool p_continuous);
+		// objects only take as many substeps as their velocity needs, up to the iterations
+		void setAdaptiveSubsteps(const bool p_adaptive, const float p_maxMovement = 0.5f);
+		// objects fall asleep after their linearVelocity was 0 for some iterations and wake up
+		// when a moving object touches them, 0 turns sleeping off
+		void setSleepIterations(const unsigned int p_iterations);
+		// reports begin, persist and end of contacts and skips pairs with a separating axis
+		void setPairCache(const bool p_enabled);
+		// static objects are kept in a StaticBVH instead of being checked against every object
+		void setStaticTree(const bool p_enabled);
+		// timings and counters of the last step, only measured with CDL_PROFILING
+		const StepStats& getStepStats() const;
 	};
 }
 
@@ -8,9 +8,25 @@
 #include "cdl/Circle.hpp"
 #include "cdl/Line.hpp"
 #include "cdl/Polygon.hpp"
+#include "cdl/AABB.hpp"
 #include "cdl/CollisionDetection.hpp"
+#include "cdl/BatchCollision.hpp"
+#include "cdl/ContactManifold.hpp"
+#include "cdl/SeparatingAxis.hpp"
+#include "cdl/GJK.hpp"
+#include "cdl/ContinuousCollision.hpp"
+#include "cdl/Raycast.hpp"
+#include "cdl/RegionQuery.hpp"
 #include "cdl/CollisionObject.hpp"
+#include "cdl/ObjectPool.hpp"
 #include "cdl/CollisionHandler.hpp"
+#include "cdl/Broadphase.hpp"
+#include "cdl/SpatialHashGrid.hpp"
+#include "cdl/SweepAndPrune.hpp"
+#include "cdl/DynamicAABBTree.hpp"
+#include "cdl/StaticBVH.hpp"
+#include "cdl/ThreadPool.hpp"
+#include "cdl/StepStats.hpp"
 #include "cdl/World.hpp"
 
 #endif
\ No newline at end of file
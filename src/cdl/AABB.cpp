@@ -0,0 +1,35 @@
+#include "cdl/AABB.hpp"
+
+namespace cdl
+{
+	void AABB::merge(const AABB &p_aabb)
+	{
+		if(p_aabb.min.x < min.x)
+			min.x = p_aabb.min.x;
+		if(p_aabb.min.y < min.y)
+			min.y = p_aabb.min.y;
+		if(p_aabb.max.x > max.x)
+			max.x = p_aabb.max.x;
+		if(p_aabb.max.y > max.y)
+			max.y = p_aabb.max.y;
+	}
+
+	void AABB::merge(const Vec2 &p_point)
+	{
+		merge(AABB(p_point, p_point));
+	}
+
+	AABB boundsOf(const Circle &p_circle)
+	{
+		Vec2 radius(p_circle.radius, p_circle.radius);
+		return AABB(p_circle.mid - radius, p_circle.mid + radius);
+	}
+
+	AABB boundsOf(const Polygon &p_polygon)
+	{
+		AABB result;
+		for(int i = 0; i < p_polygon.corners.size(); ++i)
+			result.merge(p_polygon.corners[i]);
+		return result;
+	}
+}
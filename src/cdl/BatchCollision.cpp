@@ -0,0 +1,259 @@
+#include "cdl/BatchCollision.hpp"
+#include "cdl/CollisionDetection.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cdl
+{
+	void CircleBatch::add(const Circle &p_circle)
+	{
+		midX.push_back(p_circle.mid.x);
+		midY.push_back(p_circle.mid.y);
+		radius.push_back(p_circle.radius);
+	}
+
+	void CircleBatch::clear()
+	{
+		midX.clear();
+		midY.clear();
+		radius.clear();
+	}
+
+	unsigned int CircleBatch::size() const
+	{
+		return midX.size();
+	}
+
+	Circle CircleBatch::get(const unsigned int p_index) const
+	{
+		return Circle(Vec2(midX[p_index], midY[p_index]), radius[p_index]);
+	}
+
+	void LineSegmentBatch::add(const Line &p_lineSegment)
+	{
+		x1.push_back(p_lineSegment.point1.x);
+		y1.push_back(p_lineSegment.point1.y);
+		x2.push_back(p_lineSegment.point2.x);
+		y2.push_back(p_lineSegment.point2.y);
+	}
+
+	void LineSegmentBatch::clear()
+	{
+		x1.clear();
+		y1.clear();
+		x2.clear();
+		y2.clear();
+	}
+
+	unsigned int LineSegmentBatch::size() const
+	{
+		return x1.size();
+	}
+
+	Line LineSegmentBatch::get(const unsigned int p_index) const
+	{
+		return Line(Vec2(x1[p_index], y1[p_index]), Vec2(x2[p_index], y2[p_index]));
+	}
+
+	/* The SIMD kernels do the same float operations in the same order as the
+	 * scalar functions, so both give exactly the same hits. Shapes that do
+	 * not fill a whole register are tested with the scalar functions. */
+	static unsigned int writeHits(const int p_bits, const int p_lanes, unsigned char *p_hitMask)
+	{
+		unsigned int count = 0;
+		for(int i = 0; i < p_lanes; ++i) {
+			p_hitMask[i] = (p_bits >> i) & 1;
+			count += p_hitMask[i];
+		}
+		return count;
+	}
+
+	static unsigned int overlapCircleKernel(const Circle &p_circle, const CircleBatch &p_batch, unsigned char *p_hitMask)
+	{
+		unsigned int count = 0;
+		unsigned int size = p_batch.size();
+		unsigned int i = 0;
+
+#if defined(__AVX__)
+		__m256 midX = _mm256_set1_ps(p_circle.mid.x);
+		__m256 midY = _mm256_set1_ps(p_circle.mid.y);
+		__m256 radius = _mm256_set1_ps(p_circle.radius);
+		for(; i + 8 <= size; i += 8) {
+			__m256 diffX = _mm256_sub_ps(_mm256_loadu_ps(&p_batch.midX[i]), midX);
+			__m256 diffY = _mm256_sub_ps(_mm256_loadu_ps(&p_batch.midY[i]), midY);
+			__m256 sqDistance = _mm256_add_ps(_mm256_mul_ps(diffX, diffX), _mm256_mul_ps(diffY, diffY));
+			__m256 radiusSum = _mm256_add_ps(radius, _mm256_loadu_ps(&p_batch.radius[i]));
+			__m256 hit = _mm256_cmp_ps(sqDistance, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+			count += writeHits(_mm256_movemask_ps(hit), 8, p_hitMask + i);
+		}
+#elif defined(__SSE2__)
+		__m128 midX = _mm_set1_ps(p_circle.mid.x);
+		__m128 midY = _mm_set1_ps(p_circle.mid.y);
+		__m128 radius = _mm_set1_ps(p_circle.radius);
+		for(; i + 4 <= size; i += 4) {
+			__m128 diffX = _mm_sub_ps(_mm_loadu_ps(&p_batch.midX[i]), midX);
+			__m128 diffY = _mm_sub_ps(_mm_loadu_ps(&p_batch.midY[i]), midY);
+			__m128 sqDistance = _mm_add_ps(_mm_mul_ps(diffX, diffX), _mm_mul_ps(diffY, diffY));
+			__m128 radiusSum = _mm_add_ps(radius, _mm_loadu_ps(&p_batch.radius[i]));
+			__m128 hit = _mm_cmple_ps(sqDistance, _mm_mul_ps(radiusSum, radiusSum));
+			count += writeHits(_mm_movemask_ps(hit), 4, p_hitMask + i);
+		}
+#endif
+
+		for(; i < size; ++i) {
+			p_hitMask[i] = overlapCircles(p_circle, p_batch.get(i));
+			count += p_hitMask[i];
+		}
+		return count;
+	}
+
+	static unsigned int collideLineSegmentKernel(const Line &p_lineSegment, const LineSegmentBatch &p_batch, unsigned char *p_hitMask)
+	{
+		unsigned int count = 0;
+		unsigned int size = p_batch.size();
+		unsigned int i = 0;
+
+#if defined(__AVX__)
+		__m256 x1 = _mm256_set1_ps(p_lineSegment.point1.x);
+		__m256 y1 = _mm256_set1_ps(p_lineSegment.point1.y);
+		__m256 diffX = _mm256_set1_ps(p_lineSegment.point2.x - p_lineSegment.point1.x);
+		__m256 diffY = _mm256_set1_ps(p_lineSegment.point2.y - p_lineSegment.point1.y);
+		__m256 zero = _mm256_setzero_ps();
+		__m256 one = _mm256_set1_ps(1);
+		for(; i + 8 <= size; i += 8) {
+			__m256 batchX1 = _mm256_loadu_ps(&p_batch.x1[i]);
+			__m256 batchY1 = _mm256_loadu_ps(&p_batch.y1[i]);
+			__m256 batchDiffX = _mm256_sub_ps(_mm256_loadu_ps(&p_batch.x2[i]), batchX1);
+			__m256 batchDiffY = _mm256_sub_ps(_mm256_loadu_ps(&p_batch.y2[i]), batchY1);
+			__m256 startDiffX = _mm256_sub_ps(x1, batchX1);
+			__m256 startDiffY = _mm256_sub_ps(y1, batchY1);
+
+			__m256 denominator = _mm256_sub_ps(_mm256_mul_ps(batchDiffY, diffX), _mm256_mul_ps(batchDiffX, diffY));
+			__m256 u1 = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(batchDiffX, startDiffY), _mm256_mul_ps(batchDiffY, startDiffX)), denominator);
+			__m256 u2 = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(diffX, startDiffY), _mm256_mul_ps(diffY, startDiffX)), denominator);
+
+			__m256 hit = _mm256_cmp_ps(denominator, zero, _CMP_NEQ_UQ);
+			hit = _mm256_and_ps(hit, _mm256_cmp_ps(u1, zero, _CMP_GE_OQ));
+			hit = _mm256_and_ps(hit, _mm256_cmp_ps(u1, one, _CMP_LE_OQ));
+			hit = _mm256_and_ps(hit, _mm256_cmp_ps(u2, zero, _CMP_GE_OQ));
+			hit = _mm256_and_ps(hit, _mm256_cmp_ps(u2, one, _CMP_LE_OQ));
+			count += writeHits(_mm256_movemask_ps(hit), 8, p_hitMask + i);
+		}
+#elif defined(__SSE2__)
+		__m128 x1 = _mm_set1_ps(p_lineSegment.point1.x);
+		__m128 y1 = _mm_set1_ps(p_lineSegment.point1.y);
+		__m128 diffX = _mm_set1_ps(p_lineSegment.point2.x - p_lineSegment.point1.x);
+		__m128 diffY = _mm_set1_ps(p_lineSegment.point2.y - p_lineSegment.point1.y);
+		__m128 zero = _mm_setzero_ps();
+		__m128 one = _mm_set1_ps(1);
+		for(; i + 4 <= size; i += 4) {
+			__m128 batchX1 = _mm_loadu_ps(&p_batch.x1[i]);
+			__m128 batchY1 = _mm_loadu_ps(&p_batch.y1[i]);
+			__m128 batchDiffX = _mm_sub_ps(_mm_loadu_ps(&p_batch.x2[i]), batchX1);
+			__m128 batchDiffY = _mm_sub_ps(_mm_loadu_ps(&p_batch.y2[i]), batchY1);
+			__m128 startDiffX = _mm_sub_ps(x1, batchX1);
+			__m128 startDiffY = _mm_sub_ps(y1, batchY1);
+
+			__m128 denominator = _mm_sub_ps(_mm_mul_ps(batchDiffY, diffX), _mm_mul_ps(batchDiffX, diffY));
+			__m128 u1 = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(batchDiffX, startDiffY), _mm_mul_ps(batchDiffY, startDiffX)), denominator);
+			__m128 u2 = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(diffX, startDiffY), _mm_mul_ps(diffY, startDiffX)), denominator);
+
+			__m128 hit = _mm_cmpneq_ps(denominator, zero);
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(u1, zero));
+			hit = _mm_and_ps(hit, _mm_cmple_ps(u1, one));
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(u2, zero));
+			hit = _mm_and_ps(hit, _mm_cmple_ps(u2, one));
+			count += writeHits(_mm_movemask_ps(hit), 4, p_hitMask + i);
+		}
+#endif
+
+		for(; i < size; ++i) {
+			p_hitMask[i] = overlapLineSegments(p_lineSegment, p_batch.get(i));
+			count += p_hitMask[i];
+		}
+		return count;
+	}
+
+	unsigned int overlapCircleBatch(const Circle &p_circle, const CircleBatch &p_batch, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints)
+	{
+		p_hitMask.resize(p_batch.size());
+		if(p_batch.size() == 0)
+			return 0;
+
+		unsigned int count = overlapCircleKernel(p_circle, p_batch, &p_hitMask[0]);
+		// only hits need the exact calculation
+		if(p_intersectionPoints != NULL && count > 0) {
+			for(unsigned int i = 0; i < p_batch.size(); ++i) {
+				if(p_hitMask[i])
+					collideCircles(p_circle, p_batch.get(i), *p_intersectionPoints);
+			}
+		}
+		return count;
+	}
+
+	unsigned int overlapCircleBatch(const CircleBatch &p_batch1, const CircleBatch &p_batch2, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints)
+	{
+		unsigned int size2 = p_batch2.size();
+		p_hitMask.resize(p_batch1.size() * size2);
+		if(p_hitMask.empty())
+			return 0;
+
+		unsigned int count = 0;
+		for(unsigned int i = 0; i < p_batch1.size(); ++i) {
+			Circle circle = p_batch1.get(i);
+			unsigned char *row = &p_hitMask[i * size2];
+			unsigned int rowCount = overlapCircleKernel(circle, p_batch2, row);
+			count += rowCount;
+			if(p_intersectionPoints == NULL || rowCount == 0)
+				continue;
+			for(unsigned int j = 0; j < size2; ++j) {
+				if(row[j])
+					collideCircles(circle, p_batch2.get(j), *p_intersectionPoints);
+			}
+		}
+		return count;
+	}
+
+	unsigned int collideLineSegmentBatch(const Line &p_lineSegment, const LineSegmentBatch &p_batch, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints)
+	{
+		p_hitMask.resize(p_batch.size());
+		if(p_batch.size() == 0)
+			return 0;
+
+		unsigned int count = collideLineSegmentKernel(p_lineSegment, p_batch, &p_hitMask[0]);
+		if(p_intersectionPoints != NULL && count > 0) {
+			for(unsigned int i = 0; i < p_batch.size(); ++i) {
+				if(p_hitMask[i])
+					collideLineSegments(p_lineSegment, p_batch.get(i), *p_intersectionPoints);
+			}
+		}
+		return count;
+	}
+
+	unsigned int collideLineSegmentBatch(const LineSegmentBatch &p_batch1, const LineSegmentBatch &p_batch2, std::vector<unsigned char> &p_hitMask, std::vector<Vec2> *p_intersectionPoints)
+	{
+		unsigned int size2 = p_batch2.size();
+		p_hitMask.resize(p_batch1.size() * size2);
+		if(p_hitMask.empty())
+			return 0;
+
+		unsigned int count = 0;
+		for(unsigned int i = 0; i < p_batch1.size(); ++i) {
+			Line lineSegment = p_batch1.get(i);
+			unsigned char *row = &p_hitMask[i * size2];
+			unsigned int rowCount = collideLineSegmentKernel(lineSegment, p_batch2, row);
+			count += rowCount;
+			if(p_intersectionPoints == NULL || rowCount == 0)
+				continue;
+			for(unsigned int j = 0; j < size2; ++j) {
+				if(row[j])
+					collideLineSegments(lineSegment, p_batch2.get(j), *p_intersectionPoints);
+			}
+		}
+		return count;
+	}
+}
@@ -0,0 +1,17 @@
+#include <algorithm>
+#include "cdl/Broadphase.hpp"
+
+namespace cdl
+{
+	bool operator<(CollisionPair const& p_pair1, CollisionPair const& p_pair2)
+	{
+		if(p_pair1.objectA->getID() != p_pair2.objectA->getID())
+			return p_pair1.objectA->getID() < p_pair2.objectA->getID();
+		return p_pair1.objectB->getID() < p_pair2.objectB->getID();
+	}
+
+	void sortPairs(std::vector<CollisionPair> &p_pairs)
+	{
+		std::sort(p_pairs.begin(), p_pairs.end());
+	}
+}
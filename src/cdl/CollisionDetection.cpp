@@ -2,35 +2,96 @@
 #include <algorithm>
 #include "cdl/CollisionDetection.hpp"
 
-/* Formula of line intersection:
- * u1 = LINE1_INTERSECT_FAC(l1, l2) / LINE_INTERSECT_DENOM(l1, l2)
- * u2 = LINE2_INTERSECT_FAC(l1, l2) / LINE_INTERSECT_DENOM(l1, l2)
- * u1 and u2 are used as factors to calculate intersection point */
-#define LINE_INTERSECT_DENOM(l1, l2) (((l2.point2.y - l2.point1.y) * (l1.point2.x - l1.point1.x)) - \
-									  ((l2.point2.x - l2.point1.x) * (l1.point2.y - l1.point1.y)))
-#define LINE1_INTERSECT_FAC(l1, l2) (((l2.point2.x - l2.point1.x) * (l1.point1.y - l2.point1.y)) - \
-									 ((l2.point2.y - l2.point1.y) * (l1.point1.x - l2.point1.x)))
-#define LINE2_INTERSECT_FAC(l1, l2) (((l1.point2.x - l1.point1.x) * (l1.point1.y - l2.point1.y)) - \
-								     ((l1.point2.y - l1.point1.y) * (l1.point1.x - l2.point1.x)))
-									 
-/* Formulas for line circle intersection */
-#define LINE_CIRCLE_INTERSECT_FAC_A(diffp1p2) ((diffp1p2.x) * (diffp1p2.x) + (diffp1p2.y) * (diffp1p2.y))
-#define LINE_CIRCLE_INTERSECT_FAC_B(diffp1p2, p1) (2 * ((diffp1p2.x * p1.x) + (diffp1p2.y * p1.y)))
-#define LINE_CIRCLE_INTERSECT_FAC_C(p1, rad) ((p1.x * p1.x) + (p1.y * p1.y) - (rad * rad))
-#define LINE_CIRCLE_INTERSECT_DELTA(a, b, c) (b * b - (4 * a * c))
+/* points closer than this (relative to their magnitude) are the same point */
+#define DUPLICATE_POINT_EPSILON 1e-5f
 
 namespace cdl
 {
-	static void unique(std::vector<Vec2> &p_points)
+	/* Formula of line intersection:
+	 * u1 = intersectFactor1(l1, l2) / intersectDenominator(l1, l2)
+	 * u2 = intersectFactor2(l1, l2) / intersectDenominator(l1, l2)
+	 * u1 and u2 are used as factors to calculate intersection point */
+	static float intersectDenominator(const Line &p_line1, const Line &p_line2)
 	{
-		for(int i = 0; i < p_points.size(); ++i) {
-			for(int j = i + 1; j < p_points.size(); ++j) {
-				if(p_points[i] == p_points[j]) {
-					p_points.erase(p_points.begin() + j);
-					--j;
-				}
+		return cross(p_line1.point2 - p_line1.point1, p_line2.point2 - p_line2.point1);
+	}
+	
+	static float intersectFactor1(const Line &p_line1, const Line &p_line2)
+	{
+		return cross(p_line2.point2 - p_line2.point1, p_line1.point1 - p_line2.point1);
+	}
+	
+	static float intersectFactor2(const Line &p_line1, const Line &p_line2)
+	{
+		return cross(p_line1.point2 - p_line1.point1, p_line1.point1 - p_line2.point1);
+	}
+	
+	static bool samePoint(const Vec2 &p_point1, const Vec2 &p_point2)
+	{
+		float scale = std::max(1.0f, std::max(std::max(std::fabs(p_point1.x), std::fabs(p_point1.y)),
+		                                      std::max(std::fabs(p_point2.x), std::fabs(p_point2.y))));
+		float tolerance = DUPLICATE_POINT_EPSILON * scale;
+		return std::fabs(p_point1.x - p_point2.x) <= tolerance && std::fabs(p_point1.y - p_point2.y) <= tolerance;
+	}
+	
+	/* Removes duplicates while the edges of a polygon append their points, in
+	 * place and in one pass. Duplicates come from corners that two edges share,
+	 * so a point is only compared with the points kept for its own edge, for the
+	 * last edge that kept points and, for the last edge, for the first one. */
+	class EdgePointFilter
+	{
+	private:
+		std::vector<Vec2> &points;
+		unsigned int firstStart;
+		unsigned int firstEnd;
+		unsigned int previousStart;
+		unsigned int edgeStart;
+		
+		bool contains(const unsigned int p_start, const unsigned int p_end, const Vec2 &p_point) const
+		{
+			for(unsigned int i = p_start; i < p_end; ++i) {
+				if(samePoint(points[i], p_point))
+					return true;
 			}
+			return false;
 		}
+	public:
+		EdgePointFilter(std::vector<Vec2> &p_points)
+		:points(p_points), firstStart(p_points.size()), firstEnd(p_points.size()), previousStart(p_points.size()), edgeStart(p_points.size()) { }
+		
+		// called after each edge appended its points
+		void endEdge(const bool p_lastEdge)
+		{
+			unsigned int count = edgeStart;
+			for(unsigned int i = edgeStart; i < points.size(); ++i) {
+				if(contains(previousStart, count, points[i]) || (p_lastEdge && contains(firstStart, firstEnd, points[i])))
+					continue;
+				points[count++] = points[i];
+			}
+			points.resize(count);
+			if(firstEnd == firstStart)
+				firstEnd = count;
+			if(count > edgeStart)
+				previousStart = edgeStart;
+			edgeStart = count;
+		}
+	};
+	
+	// one Line is reused for all edges
+	static bool collideLineSegmentEdges(const Line &p_line, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints)
+	{
+		bool result = false;
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		EdgePointFilter filter(p_intersectionPoints);
+		Line edge;
+		for(unsigned int i = 0; i < corners.size(); ++i) {
+			edge.point1 = corners[i];
+			edge.point2 = corners[(i + 1) % corners.size()];
+			if(collideLineSegments(p_line, edge, p_intersectionPoints))
+				result = true;
+			filter.endEdge(i + 1 == corners.size());
+		}
+		return result;
 	}
 	
 	bool collideCircles(const Circle &p_circle1, const Circle &p_circle2, std::vector<Vec2> &p_intersectionPoints)
@@ -62,11 +123,11 @@ namespace cdl
 	bool collideLines(const Line &p_line1, const Line &p_line2, std::vector<Vec2> &p_intersectionPoints)
 	{
 		// denominator of formula for line intersection
-		float denominator = LINE_INTERSECT_DENOM(p_line1, p_line2);
+		float denominator = intersectDenominator(p_line1, p_line2);
 		if(denominator == 0)
 			return false;
 		// factor to calculate resulting point
-		float u1 = LINE1_INTERSECT_FAC(p_line1, p_line2) / denominator;
+		float u1 = intersectFactor1(p_line1, p_line2) / denominator;
 		
 		// add intersection point
 		p_intersectionPoints.push_back(p_line1.point1 + (u1 * (p_line1.point2 - p_line1.point1)));
@@ -76,12 +137,12 @@ namespace cdl
 	bool collideLineSegments(const Line &p_line1, const Line &p_line2, std::vector<Vec2> &p_intersectionPoints)
 	{
 		// denominator of formula for line intersection
-		float denominator = LINE_INTERSECT_DENOM(p_line1, p_line2);
+		float denominator = intersectDenominator(p_line1, p_line2);
 		if(denominator == 0)
 			return false;
 		// factor to calculate resulting point
-		float u1 = LINE1_INTERSECT_FAC(p_line1, p_line2) / denominator;
-		float u2 = LINE2_INTERSECT_FAC(p_line1, p_line2) / denominator;
+		float u1 = intersectFactor1(p_line1, p_line2) / denominator;
+		float u2 = intersectFactor2(p_line1, p_line2) / denominator;
 		
 		// intersection point is not in between points of lines
 		if (u1 < 0 || u1 > 1 || u2 < 0 || u2 > 1)
@@ -95,10 +156,10 @@ namespace cdl
 	bool collideLineLineSegment(const Line &p_line, const Line &p_lineSegment, std::vector<Vec2> &p_intersectionPoints)
 	{
 		// denominator of formula for line intersection
-		float denominator = LINE_INTERSECT_DENOM(p_line, p_lineSegment);
+		float denominator = intersectDenominator(p_line, p_lineSegment);
 		if(denominator == 0)
 			return false;
-		float u = LINE2_INTERSECT_FAC(p_line, p_lineSegment) / denominator;
+		float u = intersectFactor2(p_line, p_lineSegment) / denominator;
 		
 		// intersection point is not in between points of lineSegment
 		if (u < 0 || u > 1)
@@ -116,10 +177,11 @@ namespace cdl
 		// direction vector of the line
 		Vec2 diffP2P1 = localPoint2 - localPoint1;
 		
-		float a = LINE_CIRCLE_INTERSECT_FAC_A(diffP2P1);
-		float b = LINE_CIRCLE_INTERSECT_FAC_B(diffP2P1, localPoint1);
-		float c = LINE_CIRCLE_INTERSECT_FAC_C(localPoint1, p_circle.radius);
-		float delta = LINE_CIRCLE_INTERSECT_DELTA(a, b, c);
+		// solve |localPoint1 + u * diffP2P1| = radius
+		float a = dot(diffP2P1, diffP2P1);
+		float b = 2 * dot(diffP2P1, localPoint1);
+		float c = dot(localPoint1, localPoint1) - p_circle.radius * p_circle.radius;
+		float delta = b * b - 4 * a * c;
 		//no intersection
 		if (delta < 0)
 			return false;
@@ -147,10 +209,11 @@ namespace cdl
 		// direction vector of the line
 		Vec2 diffP2P1 = localPoint2 - localPoint1;
 		
-		float a = LINE_CIRCLE_INTERSECT_FAC_A(diffP2P1);
-		float b = LINE_CIRCLE_INTERSECT_FAC_B(diffP2P1, localPoint1);
-		float c = LINE_CIRCLE_INTERSECT_FAC_C(localPoint1, p_circle.radius);
-		float delta = LINE_CIRCLE_INTERSECT_DELTA(a, b, c);
+		// solve |localPoint1 + u * diffP2P1| = radius
+		float a = dot(diffP2P1, diffP2P1);
+		float b = 2 * dot(diffP2P1, localPoint1);
+		float c = dot(localPoint1, localPoint1) - p_circle.radius * p_circle.radius;
+		float delta = b * b - 4 * a * c;
 		//no intersection
 		if (delta < 0)
 			return false;
@@ -186,81 +249,216 @@ namespace cdl
 	bool collidePolygons(const Polygon &p_polygon1, const Polygon &p_polygon2, std::vector<Vec2> &p_intersectionPoints)
 	{
 		bool result = false;
-		int next;
-		std::vector<Vec2> resultList;
+		const std::vector<Vec2> &corners = p_polygon1.corners;
+		// a corner of polygon1 on polygon2 is found by both of its edges
+		EdgePointFilter filter(p_intersectionPoints);
 		
-		for(int i = 0; i < p_polygon1.corners.size(); ++i) {
-			next = (i + 1) % p_polygon1.corners.size();
+		Line edge;
+		for(unsigned int i = 0; i < corners.size(); ++i) {
+			edge.point1 = corners[i];
+			edge.point2 = corners[(i + 1) % corners.size()];
 			//collide all line segments of polygon1 with polygon 2
-			if(collideLineSegmentPolygon(Line(p_polygon1.corners[i], p_polygon1.corners[next]), p_polygon2, resultList))
+			if(collideLineSegmentEdges(edge, p_polygon2, p_intersectionPoints))
 				result = true;
+			filter.endEdge(i + 1 == corners.size());
 		}
 		
-		// if collision is right on corner, there may be duplicates from each lineSegment of polygon
-		unique(resultList);
-		p_intersectionPoints.insert(p_intersectionPoints.end(), resultList.begin(), resultList.end());
-		
 		return result;
 	}
 	
 	bool collideLinePolygon(const Line &p_line, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints)
 	{
 		bool result = false;
-		int next;
-		std::vector<Vec2> resultList;
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		// if collision is right on corner, both lineSegments of the corner find it
+		EdgePointFilter filter(p_intersectionPoints);
 		
-		for(int i = 0; i < p_polygon.corners.size(); ++i) {
-			next = (i + 1) % p_polygon.corners.size();
+		Line edge;
+		for(unsigned int i = 0; i < corners.size(); ++i) {
+			edge.point1 = corners[i];
+			edge.point2 = corners[(i + 1) % corners.size()];
 			//collide all line segments of the polygon with the line
-			if(collideLineLineSegment(p_line, Line(p_polygon.corners[i], p_polygon.corners[next]), resultList))
+			if(collideLineLineSegment(p_line, edge, p_intersectionPoints))
 				result = true;
+			filter.endEdge(i + 1 == corners.size());
 		}
 		
-		// if collision is right on corner, there may be duplicates from each lineSegment of polygon
-		unique(resultList);
-		p_intersectionPoints.insert(p_intersectionPoints.end(), resultList.begin(), resultList.end());
-		
 		return result;
 	}
 	
 	bool collideLineSegmentPolygon(const Line &p_line, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints)
+	{
+		// duplicates at corners are removed while the edges are checked
+		return collideLineSegmentEdges(p_line, p_polygon, p_intersectionPoints);
+	}
+	
+	bool collideCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints)
 	{
 		bool result = false;
-		int next;
-		std::vector<Vec2> resultList;
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		// if collision is right on corner, both lineSegments of the corner find it
+		EdgePointFilter filter(p_intersectionPoints);
 		
+		Line edge;
+		for(unsigned int i = 0; i < corners.size(); ++i) {
+			edge.point1 = corners[i];
+			edge.point2 = corners[(i + 1) % corners.size()];
+			//collide all line segments of polygon with circle
+			if(collideLineSegmentCircle(edge, p_circle, p_intersectionPoints))
+				result = true;
+			filter.endEdge(i + 1 == corners.size());
+		}
+		
+		return result;
+	}
+	
+	// square distance of a point to the closest point of a line segment
+	static float sqDistancePointLineSegment(const Vec2 &p_point, const Line &p_line)
+	{
+		Vec2 diffP2P1 = p_line.point2 - p_line.point1;
+		Vec2 diffPointP1 = p_point - p_line.point1;
+		float lengthSQ = diffP2P1.lengthSQ();
+		float u = 0;
+		if(lengthSQ > 0)
+			u = dot(diffPointP1, diffP2P1) / lengthSQ;
+		if(u < 0)
+			u = 0;
+		else if(u > 1)
+			u = 1;
+		return (diffPointP1 - (u * diffP2P1)).lengthSQ();
+	}
+	
+	bool overlapPointCircle(const Vec2 &p_point, const Circle &p_circle)
+	{
+		return (p_point - p_circle.mid).lengthSQ() <= p_circle.radius * p_circle.radius;
+	}
+	
+	bool overlapPointPolygon(const Vec2 &p_point, const Polygon &p_polygon)
+	{
+		// count crossings of a ray from the point in x direction with all edges
+		bool inside = false;
+		int next;
 		for(int i = 0; i < p_polygon.corners.size(); ++i) {
 			next = (i + 1) % p_polygon.corners.size();
-			// collide all line segments of polygon with line segment
-			if(collideLineSegments(p_line, Line(p_polygon.corners[i], p_polygon.corners[next]), resultList))
-				result = true;
+			const Vec2 &corner1 = p_polygon.corners[i];
+			const Vec2 &corner2 = p_polygon.corners[next];
+			if((corner1.y > p_point.y) != (corner2.y > p_point.y)) {
+				float crossX = corner1.x + (p_point.y - corner1.y) * (corner2.x - corner1.x) / (corner2.y - corner1.y);
+				if(p_point.x < crossX)
+					inside = !inside;
+			}
 		}
 		
-		// if collision is right on corner, there may be duplicates from each lineSegment of polygon
-		unique(resultList);
-		p_intersectionPoints.insert(p_intersectionPoints.end(), resultList.begin(), resultList.end());
+		return inside;
+	}
+	
+	bool overlapCircles(const Circle &p_circle1, const Circle &p_circle2)
+	{
+		float radiusSum = p_circle1.radius + p_circle2.radius;
+		return (p_circle2.mid - p_circle1.mid).lengthSQ() <= radiusSum * radiusSum;
+	}
+	
+	bool overlapLines(const Line &p_line1, const Line &p_line2)
+	{
+		// only parallel lines do not intersect
+		return intersectDenominator(p_line1, p_line2) != 0;
+	}
+	
+	bool overlapLineSegments(const Line &p_line1, const Line &p_line2)
+	{
+		float denominator = intersectDenominator(p_line1, p_line2);
+		if(denominator == 0)
+			return false;
+		float u1 = intersectFactor1(p_line1, p_line2) / denominator;
+		if (u1 < 0 || u1 > 1)
+			return false;
+		float u2 = intersectFactor2(p_line1, p_line2) / denominator;
+		return u2 >= 0 && u2 <= 1;
+	}
+	
+	bool overlapLineLineSegment(const Line &p_line, const Line &p_lineSegment)
+	{
+		float denominator = intersectDenominator(p_line, p_lineSegment);
+		if(denominator == 0)
+			return false;
+		float u = intersectFactor2(p_line, p_lineSegment) / denominator;
+		return u >= 0 && u <= 1;
+	}
+	
+	bool overlapLineCircle(const Line &p_line, const Circle &p_circle)
+	{
+		Vec2 localPoint1 = p_line.point1 - p_circle.mid;
+		Vec2 localPoint2 = p_line.point2 - p_circle.mid;
+		Vec2 diffP2P1 = localPoint2 - localPoint1;
+		
+		// solve |localPoint1 + u * diffP2P1| = radius
+		float a = dot(diffP2P1, diffP2P1);
+		float b = 2 * dot(diffP2P1, localPoint1);
+		float c = dot(localPoint1, localPoint1) - p_circle.radius * p_circle.radius;
+		return b * b - 4 * a * c >= 0;
+	}
+	
+	bool overlapLineSegmentCircle(const Line &p_line, const Circle &p_circle)
+	{
+		// also true if the line segment is inside of the circle
+		return sqDistancePointLineSegment(p_circle.mid, p_line) <= p_circle.radius * p_circle.radius;
+	}
+	
+	bool overlapPolygons(const Polygon &p_polygon1, const Polygon &p_polygon2)
+	{
+		int next;
+		for(int i = 0; i < p_polygon1.corners.size(); ++i) {
+			next = (i + 1) % p_polygon1.corners.size();
+			if(overlapLineSegmentPolygon(Line(p_polygon1.corners[i], p_polygon1.corners[next]), p_polygon2))
+				return true;
+		}
 		
-		return result;
+		// no edges cross, polygon2 can still be inside of polygon1
+		return !p_polygon2.corners.empty() && overlapPointPolygon(p_polygon2.corners[0], p_polygon1);
 	}
 	
-	bool collideCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, std::vector<Vec2> &p_intersectionPoints)
+	bool overlapLinePolygon(const Line &p_line, const Polygon &p_polygon)
 	{
-		bool result = false;
 		int next;
-		std::vector<Vec2> resultList;
+		for(int i = 0; i < p_polygon.corners.size(); ++i) {
+			next = (i + 1) % p_polygon.corners.size();
+			if(overlapLineLineSegment(p_line, Line(p_polygon.corners[i], p_polygon.corners[next])))
+				return true;
+		}
 		
+		return false;
+	}
+	
+	bool overlapLineSegmentPolygon(const Line &p_line, const Polygon &p_polygon)
+	{
+		// line segment can be inside of the polygon
+		if(overlapPointPolygon(p_line.point1, p_polygon))
+			return true;
+		
+		int next;
 		for(int i = 0; i < p_polygon.corners.size(); ++i) {
 			next = (i + 1) % p_polygon.corners.size();
-			//collide all line segments of polygon with circle
-			if(collideLineSegmentCircle(Line(p_polygon.corners[i], p_polygon.corners[next]), p_circle, resultList))
-				result = true;
+			if(overlapLineSegments(p_line, Line(p_polygon.corners[i], p_polygon.corners[next])))
+				return true;
 		}
 		
-		// if collision is right on corner, there may be duplicates from each lineSegment of polygon
-		unique(resultList);
-		p_intersectionPoints.insert(p_intersectionPoints.end(), resultList.begin(), resultList.end());
+		return false;
+	}
+	
+	bool overlapCirclePolygon(const Circle &p_circle, const Polygon &p_polygon)
+	{
+		// circle can be inside of the polygon
+		if(overlapPointPolygon(p_circle.mid, p_polygon))
+			return true;
 		
-		return result;
+		// an edge touching the circle or the polygon being inside of the circle
+		int next;
+		for(int i = 0; i < p_polygon.corners.size(); ++i) {
+			next = (i + 1) % p_polygon.corners.size();
+			if(overlapLineSegmentCircle(Line(p_polygon.corners[i], p_polygon.corners[next]), p_circle))
+				return true;
+		}
+		
+		return false;
 	}
 }
-
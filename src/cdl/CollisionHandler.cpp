@@ -0,0 +1,33 @@
+#include "cdl/CollisionHandler.hpp"
+
+namespace cdl
+{
+	void CollisionEventBuffer::add(CollisionObject *p_objectA, CollisionObject *p_objectB, const std::vector<Vec2> &p_intersectionPoints, const float p_time)
+	{
+		Entry entry;
+		entry.objectA = p_objectA;
+		entry.objectB = p_objectB;
+		entry.pointStart = pointVec.size();
+		entry.pointCount = p_intersectionPoints.size();
+		entry.time = p_time;
+		entryVec.push_back(entry);
+		pointVec.insert(pointVec.end(), p_intersectionPoints.begin(), p_intersectionPoints.end());
+	}
+	
+	void CollisionEventBuffer::clear()
+	{
+		entryVec.clear();
+		pointVec.clear();
+	}
+	
+	void CollisionHandler::collideBatch(CollisionEventBuffer &p_events)
+	{
+		// events expect their points in a vector, reuse the same one for all of them
+		for(unsigned int i = 0; i < p_events.size(); ++i) {
+			const Vec2 *points = p_events.getIntersectionPoints(i);
+			batchPointVec.assign(points, points + p_events.getIntersectionPointCount(i));
+			CollisionEvent event(batchPointVec, p_events.getObjectA(i), p_events.getObjectB(i), p_events.getTime(i));
+			collide(event);
+		}
+	}
+}
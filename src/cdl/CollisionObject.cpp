@@ -1,31 +1,52 @@
 #include <cmath>
 #include "cdl/CollisionObject.hpp"
+#include "cdl/SeparatingAxis.hpp"
 
 namespace cdl
 {
+	bool operator==(ObjectHandle const& p_handle1, ObjectHandle const& p_handle2)
+	{
+		return p_handle1.slot == p_handle2.slot && p_handle1.generation == p_handle2.generation;
+	}
+	
+	bool operator!=(ObjectHandle const& p_handle1, ObjectHandle const& p_handle2)
+	{
+		return !(p_handle1 == p_handle2);
+	}
+	
+	void CollisionObject::reset(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles)
+	{
+		// assigning keeps the memory of the vectors and the corners of their polygons
+		polygonVec = p_polygons;
+		circleVec = p_circles;
+		direction = 0;
+		rotationCos = 1;
+		rotationSin = 0;
+		userData = NULL;
+		position.set(0, 0);
+		linearVelocity.set(0, 0);
+		substeps = 1;
+		staticBody = false;
+		inStaticTree = false;
+		wakeUp();
+		worldShapesDirty = true;
+		updateConvexity();
+	}
+	
 	void CollisionObject::setDirection(float p_radian)
 	{
+		// local shapes stay untouched, the rotation is applied when the world shapes are updated
 		direction = p_radian;
-		float tanVal;
-		tanVal = tanf(direction);
-		
-		//rotate all circles
-		for(int i = 0; i < circleVec.size(); ++i)
-			rotatePoint(circleVec[i].mid, tanVal);
-		
-		//rotate all polygons
-		for(int i = 0; i < polygonVec.size(); ++i) {
-			for(int j = 0; j < polygonVec[i].corners.size(); ++j)
-				rotatePoint(polygonVec[i].corners[j], tanVal);
-		}
+		rotationCos = cos(direction);
+		rotationSin = sin(direction);
+		worldShapesDirty = true;
 	}
 	
-	void CollisionObject::rotatePoint(Vec2 &p_point, float p_tanVal)
+	void CollisionObject::updateConvexity()
 	{
-		float x, y;
-		x = p_point.y / p_tanVal;
-		y = p_point.x * p_tanVal;
-		p_point.set(x, y);
+		polygonConvexVec.resize(polygonVec.size());
+		for(int i = 0; i < polygonVec.size(); ++i)
+			polygonConvexVec[i] = isConvex(polygonVec[i]);
 	}
 	
 	float CollisionObject::getDirection() const
@@ -33,6 +54,26 @@ namespace cdl
 		return direction;
 	}
 	
+	unsigned int CollisionObject::getID() const
+	{
+		return id;
+	}
+	
+	unsigned int CollisionObject::getIndex() const
+	{
+		return index;
+	}
+	
+	ObjectHandle CollisionObject::getHandle() const
+	{
+		return handle;
+	}
+	
+	const AABB& CollisionObject::bounds() const
+	{
+		return worldBounds;
+	}
+	
 	const std::vector<Polygon>& CollisionObject::polygons() const
 	{
 		return polygonVec;
@@ -42,4 +83,93 @@ namespace cdl
 	{
 		return circleVec;
 	}
+	
+	bool CollisionObject::isPolygonConvex(const unsigned int p_index) const
+	{
+		return polygonConvexVec[p_index];
+	}
+	
+	void CollisionObject::setStatic(const bool p_static)
+	{
+		staticBody = p_static;
+		wakeUp();
+	}
+	
+	bool CollisionObject::isStatic() const
+	{
+		return staticBody;
+	}
+	
+	bool CollisionObject::isSleeping() const
+	{
+		return sleeping;
+	}
+	
+	bool CollisionObject::isIdle() const
+	{
+		return staticBody || sleeping;
+	}
+	
+	void CollisionObject::wakeUp()
+	{
+		sleeping = false;
+		idleIterations = 0;
+	}
+	
+	void CollisionObject::updateWorldShapes()
+	{
+		if(!worldShapesDirty && worldPosition == position)
+			return;
+		
+		// resizing keeps the memory of the last update
+		const float c = rotationCos;
+		const float s = rotationSin;
+		worldBounds = AABB();
+		worldCircleVec.resize(circleVec.size());
+		worldCircleBoundsVec.resize(circleVec.size());
+		for(int i = 0; i < circleVec.size(); ++i) {
+			worldCircleVec[i].mid = rotate(circleVec[i].mid, c, s) + position;
+			worldCircleVec[i].radius = circleVec[i].radius;
+			worldCircleBoundsVec[i] = boundsOf(worldCircleVec[i]);
+			worldBounds.merge(worldCircleBoundsVec[i]);
+		}
+		
+		worldPolygonVec.resize(polygonVec.size());
+		worldPolygonBoundsVec.resize(polygonVec.size());
+		for(int i = 0; i < polygonVec.size(); ++i) {
+			const std::vector<Vec2> &corners = polygonVec[i].corners;
+			std::vector<Vec2> &worldCorners = worldPolygonVec[i].corners;
+			worldCorners.resize(corners.size());
+			// one pass without branches over all corners, the compiler can vectorize it
+			const Vec2 *local = corners.empty() ? NULL : &corners[0];
+			Vec2 *world = worldCorners.empty() ? NULL : &worldCorners[0];
+			for(int j = 0; j < corners.size(); ++j)
+				world[j] = rotate(local[j], c, s) + position;
+			worldPolygonBoundsVec[i] = boundsOf(worldPolygonVec[i]);
+			worldBounds.merge(worldPolygonBoundsVec[i]);
+		}
+		
+		worldPosition = position;
+		worldShapesDirty = false;
+	}
+	
+	const std::vector<Polygon>& CollisionObject::worldPolygons() const
+	{
+		return worldPolygonVec;
+	}
+	
+	const std::vector<Circle>& CollisionObject::worldCircles() const
+	{
+		return worldCircleVec;
+	}
+	
+	const std::vector<AABB>& CollisionObject::worldPolygonBounds() const
+	{
+		return worldPolygonBoundsVec;
+	}
+	
+	const std::vector<AABB>& CollisionObject::worldCircleBounds() const
+	{
+		return worldCircleBoundsVec;
+	}
 }
\ No newline at end of file
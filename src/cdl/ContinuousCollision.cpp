@@ -0,0 +1,161 @@
+#include <cmath>
+#include <cfloat>
+#include "cdl/ContinuousCollision.hpp"
+
+#define SWEEP_MAX_ITERATIONS 32
+// distance at which shapes count as touching
+#define SWEEP_TOLERANCE 1e-4f
+
+namespace cdl
+{
+	bool sweepCircles(const Circle &p_circle1, const Vec2 &p_velocity1, const Circle &p_circle2, const Vec2 &p_velocity2, const float p_sec, float &p_time)
+	{
+		// circle 2 moves relative to circle 1, solve |distance + velocity * t| = radius
+		Vec2 distance = p_circle2.mid - p_circle1.mid;
+		Vec2 velocity = p_velocity2 - p_velocity1;
+		float radius = p_circle1.radius + p_circle2.radius;
+
+		float c = dot(distance, distance) - radius * radius;
+		if(c <= 0) {
+			p_time = 0;
+			return true;
+		}
+
+		float a = dot(velocity, velocity);
+		float b = dot(distance, velocity);
+		// circles do not move towards each other
+		if(a == 0 || b >= 0)
+			return false;
+		float discriminant = b * b - a * c;
+		if(discriminant < 0)
+			return false;
+
+		float time = (-b - sqrt(discriminant)) / a;
+		if(time > p_sec)
+			return false;
+		p_time = time;
+		return true;
+	}
+
+	bool sweepConvexShapes(const ConvexShape &p_shapeA, const Vec2 &p_velocityA, const ConvexShape &p_shapeB, const Vec2 &p_velocityB, const float p_sec, float &p_time)
+	{
+		// shape B moves relative to shape A
+		ConvexShape shapeB(p_shapeB);
+		Vec2 velocity = p_velocityB - p_velocityA;
+		Vec2 startOffset = p_shapeB.getOffset();
+		Vec2 pointA, pointB;
+		float time = 0;
+
+		for(int iteration = 0; iteration < SWEEP_MAX_ITERATIONS; ++iteration) {
+			shapeB.setOffset(startOffset + time * velocity);
+			float distance = gjkDistance(p_shapeA, shapeB, pointA, pointB);
+			if(distance <= SWEEP_TOLERANCE) {
+				p_time = time;
+				return true;
+			}
+
+			// shapes cannot get closer faster than B moves along the normal
+			float approach = -dot(velocity, (pointB - pointA) / distance);
+			if(approach <= 0)
+				return false;
+			time += distance / approach;
+			if(time > p_sec)
+				return false;
+		}
+
+		// still approaching, but very slowly
+		p_time = time;
+		return true;
+	}
+
+	class SweepShape
+	{
+	public:
+		ConvexShape shape;
+		bool isCircle;
+		const Circle *circle;
+
+		SweepShape(const Circle &p_circle): shape(p_circle), isCircle(true), circle(&p_circle) { }
+		SweepShape(const Polygon &p_polygon): shape(p_polygon), isCircle(false), circle(NULL) { }
+		SweepShape(const Line &p_lineSegment): shape(p_lineSegment), isCircle(false), circle(NULL) { }
+	};
+
+	static void sweepShapes(const SweepShape &p_shapeA, const Vec2 &p_velocityA, const SweepShape &p_shapeB, const Vec2 &p_velocityB, float &p_sec, bool &p_hit, ConvexShape &p_hitA, ConvexShape &p_hitB)
+	{
+		float time;
+		bool hit;
+		if(p_shapeA.isCircle && p_shapeB.isCircle)
+			hit = sweepCircles(*p_shapeA.circle, p_velocityA, *p_shapeB.circle, p_velocityB, p_sec, time);
+		else
+			hit = sweepConvexShapes(p_shapeA.shape, p_velocityA, p_shapeB.shape, p_velocityB, p_sec, time);
+
+		// limit only lets earlier hits through, keep the first of equally early ones
+		if(hit && (!p_hit || time < p_sec)) {
+			p_sec = time;
+			p_hit = true;
+			p_hitA = p_shapeA.shape;
+			p_hitB = p_shapeB.shape;
+		}
+	}
+
+	static void sweepShapeObject(const SweepShape &p_shape, const CollisionObject &p_objectA, const CollisionObject &p_objectB, float &p_sec, bool &p_hit, ConvexShape &p_hitA, ConvexShape &p_hitB)
+	{
+		const std::vector<Circle> &circles = p_objectB.worldCircles();
+		const std::vector<Polygon> &polygons = p_objectB.worldPolygons();
+
+		for(int i = 0; i < circles.size(); ++i)
+			sweepShapes(p_shape, p_objectA.linearVelocity, SweepShape(circles[i]), p_objectB.linearVelocity, p_sec, p_hit, p_hitA, p_hitB);
+
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(p_objectB.isPolygonConvex(i)) {
+				sweepShapes(p_shape, p_objectA.linearVelocity, SweepShape(polygons[i]), p_objectB.linearVelocity, p_sec, p_hit, p_hitA, p_hitB);
+				continue;
+			}
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j)
+				sweepShapes(p_shape, p_objectA.linearVelocity, SweepShape(Line(corners[j], corners[(j + 1) % corners.size()])), p_objectB.linearVelocity, p_sec, p_hit, p_hitA, p_hitB);
+		}
+	}
+
+	bool sweepObjects(const CollisionObject &p_objectA, const CollisionObject &p_objectB, const float p_sec, float &p_time, Vec2 &p_point)
+	{
+		const std::vector<Circle> &circles = p_objectA.worldCircles();
+		const std::vector<Polygon> &polygons = p_objectA.worldPolygons();
+		// shapes of the earliest hit, the time limit shrinks with every hit
+		ConvexShape hitA((Line()));
+		ConvexShape hitB((Line()));
+		float sec = p_sec;
+		bool hit = false;
+
+		for(int i = 0; i < circles.size(); ++i)
+			sweepShapeObject(SweepShape(circles[i]), p_objectA, p_objectB, sec, hit, hitA, hitB);
+
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(p_objectA.isPolygonConvex(i)) {
+				sweepShapeObject(SweepShape(polygons[i]), p_objectA, p_objectB, sec, hit, hitA, hitB);
+				continue;
+			}
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j)
+				sweepShapeObject(SweepShape(Line(corners[j], corners[(j + 1) % corners.size()])), p_objectA, p_objectB, sec, hit, hitA, hitB);
+		}
+
+		if(!hit)
+			return false;
+
+		// contact is in the middle of the closest points at the time of impact,
+		// shapes may already overlap a little
+		ContactManifold manifold;
+		hitA.setOffset(sec * p_objectA.linearVelocity);
+		hitB.setOffset(sec * p_objectB.linearVelocity);
+		if(gjkCollide(hitA, hitB, manifold)) {
+			p_point = manifold.points[0];
+		} else {
+			Vec2 pointA, pointB;
+			gjkDistance(hitA, hitB, pointA, pointB);
+			p_point = 0.5f * (pointA + pointB);
+		}
+		p_time = sec;
+		return true;
+	}
+}
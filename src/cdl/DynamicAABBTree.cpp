@@ -0,0 +1,331 @@
+#include <algorithm>
+#include "cdl/DynamicAABBTree.hpp"
+
+namespace cdl
+{
+	// half of the perimeter takes the place of the surface area in 2D
+	static float halfPerimeter(const AABB &p_bounds)
+	{
+		return (p_bounds.max.x - p_bounds.min.x) + (p_bounds.max.y - p_bounds.min.y);
+	}
+
+	static AABB mergeBounds(const AABB &p_bounds1, const AABB &p_bounds2)
+	{
+		AABB result = p_bounds1;
+		result.merge(p_bounds2);
+		return result;
+	}
+
+	static bool containsBounds(const AABB &p_outer, const AABB &p_inner)
+	{
+		return p_outer.min.x <= p_inner.min.x && p_outer.min.y <= p_inner.min.y && p_inner.max.x <= p_outer.max.x && p_inner.max.y <= p_outer.max.y;
+	}
+
+	void DynamicAABBTree::setMargin(const float p_margin)
+	{
+		// leaves get the new margin when they are inserted again
+		margin = p_margin;
+	}
+
+	float DynamicAABBTree::getMargin() const
+	{
+		return margin;
+	}
+
+	int DynamicAABBTree::getHeight() const
+	{
+		return root < 0 ? 0 : nodeVec[root].height;
+	}
+
+	int DynamicAABBTree::allocateNode()
+	{
+		if(freeNode < 0) {
+			nodeVec.push_back(Node());
+			freeNode = nodeVec.size() - 1;
+			nodeVec[freeNode].proxy = -1;
+		}
+
+		int result = freeNode;
+		freeNode = nodeVec[result].proxy;
+		Node &node = nodeVec[result];
+		node.parent = -1;
+		node.left = -1;
+		node.right = -1;
+		node.height = 0;
+		node.proxy = -1;
+		return result;
+	}
+
+	void DynamicAABBTree::freeNodeAt(const int p_node)
+	{
+		nodeVec[p_node].proxy = freeNode;
+		nodeVec[p_node].height = -1;
+		freeNode = p_node;
+	}
+
+	void DynamicAABBTree::insertLeaf(const int p_leaf)
+	{
+		if(root < 0) {
+			root = p_leaf;
+			nodeVec[p_leaf].parent = -1;
+			return;
+		}
+
+		// descend to the sibling that enlarges the tree the least
+		AABB leafBounds = nodeVec[p_leaf].bounds;
+		int index = root;
+		while(!nodeVec[index].isLeaf()) {
+			const Node &node = nodeVec[index];
+			float combinedCost = halfPerimeter(mergeBounds(node.bounds, leafBounds));
+			float cost = 2 * combinedCost;
+			// every ancestor of the new leaf grows with it
+			float inheritedCost = 2 * (combinedCost - halfPerimeter(node.bounds));
+
+			float leftCost = halfPerimeter(mergeBounds(nodeVec[node.left].bounds, leafBounds)) + inheritedCost;
+			if(!nodeVec[node.left].isLeaf())
+				leftCost -= halfPerimeter(nodeVec[node.left].bounds);
+			float rightCost = halfPerimeter(mergeBounds(nodeVec[node.right].bounds, leafBounds)) + inheritedCost;
+			if(!nodeVec[node.right].isLeaf())
+				rightCost -= halfPerimeter(nodeVec[node.right].bounds);
+
+			if(cost < leftCost && cost < rightCost)
+				break;
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		// new parent takes the place of the sibling
+		int sibling = index;
+		int oldParent = nodeVec[sibling].parent;
+		int newParent = allocateNode();
+		nodeVec[newParent].parent = oldParent;
+		nodeVec[newParent].bounds = mergeBounds(leafBounds, nodeVec[sibling].bounds);
+		nodeVec[newParent].height = nodeVec[sibling].height + 1;
+		nodeVec[newParent].left = sibling;
+		nodeVec[newParent].right = p_leaf;
+		if(oldParent < 0)
+			root = newParent;
+		else if(nodeVec[oldParent].left == sibling)
+			nodeVec[oldParent].left = newParent;
+		else
+			nodeVec[oldParent].right = newParent;
+		nodeVec[sibling].parent = newParent;
+		nodeVec[p_leaf].parent = newParent;
+
+		refit(newParent);
+	}
+
+	void DynamicAABBTree::removeLeaf(const int p_leaf)
+	{
+		if(p_leaf == root) {
+			root = -1;
+			return;
+		}
+
+		// sibling takes the place of the parent
+		int parent = nodeVec[p_leaf].parent;
+		int grandParent = nodeVec[parent].parent;
+		int sibling = nodeVec[parent].left == p_leaf ? nodeVec[parent].right : nodeVec[parent].left;
+		nodeVec[sibling].parent = grandParent;
+		freeNodeAt(parent);
+		if(grandParent < 0) {
+			root = sibling;
+			return;
+		}
+
+		if(nodeVec[grandParent].left == parent)
+			nodeVec[grandParent].left = sibling;
+		else
+			nodeVec[grandParent].right = sibling;
+		refit(grandParent);
+	}
+
+	void DynamicAABBTree::refit(int p_node)
+	{
+		while(p_node >= 0) {
+			p_node = balance(p_node);
+			Node &node = nodeVec[p_node];
+			node.height = 1 + std::max(nodeVec[node.left].height, nodeVec[node.right].height);
+			node.bounds = mergeBounds(nodeVec[node.left].bounds, nodeVec[node.right].bounds);
+			p_node = node.parent;
+		}
+	}
+
+	int DynamicAABBTree::balance(const int p_node)
+	{
+		Node &nodeA = nodeVec[p_node];
+		if(nodeA.isLeaf() || nodeA.height < 2)
+			return p_node;
+
+		// higher child is rotated up, its higher child stays below it
+		int indexB = nodeA.left;
+		int indexC = nodeA.right;
+		int difference = nodeVec[indexC].height - nodeVec[indexB].height;
+		if(difference >= -1 && difference <= 1)
+			return p_node;
+
+		int indexUp = difference > 1 ? indexC : indexB;
+		int indexStay = difference > 1 ? indexB : indexC;
+		Node &nodeUp = nodeVec[indexUp];
+		int indexF = nodeUp.left;
+		int indexG = nodeUp.right;
+
+		nodeUp.left = p_node;
+		nodeUp.parent = nodeA.parent;
+		nodeA.parent = indexUp;
+		if(nodeUp.parent < 0)
+			root = indexUp;
+		else if(nodeVec[nodeUp.parent].left == p_node)
+			nodeVec[nodeUp.parent].left = indexUp;
+		else
+			nodeVec[nodeUp.parent].right = indexUp;
+
+		int indexHigh = nodeVec[indexF].height > nodeVec[indexG].height ? indexF : indexG;
+		int indexLow = indexHigh == indexF ? indexG : indexF;
+		nodeUp.right = indexHigh;
+		if(difference > 1)
+			nodeA.right = indexLow;
+		else
+			nodeA.left = indexLow;
+		nodeVec[indexLow].parent = p_node;
+
+		nodeA.bounds = mergeBounds(nodeVec[indexStay].bounds, nodeVec[indexLow].bounds);
+		nodeA.height = 1 + std::max(nodeVec[indexStay].height, nodeVec[indexLow].height);
+		nodeUp.bounds = mergeBounds(nodeA.bounds, nodeVec[indexHigh].bounds);
+		nodeUp.height = 1 + std::max(nodeA.height, nodeVec[indexHigh].height);
+		return indexUp;
+	}
+
+	void DynamicAABBTree::updateProxy(const unsigned int p_proxy, const AABB &p_bounds)
+	{
+		Proxy &proxy = proxyVec[p_proxy];
+		proxy.bounds = p_bounds;
+
+		// objects without shapes have empty bounds and are not in the tree
+		if(proxy.bounds.isEmpty()) {
+			if(proxy.leaf >= 0) {
+				removeLeaf(proxy.leaf);
+				freeNodeAt(proxy.leaf);
+				proxy.leaf = -1;
+			}
+			return;
+		}
+
+		// object is still inside of its fat bounds
+		if(proxy.leaf >= 0 && containsBounds(nodeVec[proxy.leaf].bounds, proxy.bounds))
+			return;
+
+		if(proxy.leaf >= 0)
+			removeLeaf(proxy.leaf);
+		else
+			proxy.leaf = allocateNode();
+		Node &leaf = nodeVec[proxy.leaf];
+		leaf.bounds = AABB(proxy.bounds.min - Vec2(margin, margin), proxy.bounds.max + Vec2(margin, margin));
+		leaf.left = -1;
+		leaf.right = -1;
+		leaf.height = 0;
+		leaf.proxy = p_proxy;
+		insertLeaf(proxy.leaf);
+	}
+
+	void DynamicAABBTree::addObject(CollisionObject *p_object)
+	{
+		Proxy proxy;
+		proxy.object = p_object;
+		proxy.leaf = -1;
+		proxyVec.push_back(proxy);
+		proxyMap[p_object] = proxyVec.size() - 1;
+
+		// new objects have no bounds yet, they are inserted in the next step
+		updateProxy(proxyVec.size() - 1, p_object->bounds());
+	}
+
+	void DynamicAABBTree::removeObject(CollisionObject *p_object)
+	{
+		std::unordered_map<CollisionObject*, unsigned int>::iterator it = proxyMap.find(p_object);
+		if(it == proxyMap.end())
+			return;
+
+		unsigned int index = it->second;
+		proxyMap.erase(it);
+		if(proxyVec[index].leaf >= 0) {
+			removeLeaf(proxyVec[index].leaf);
+			freeNodeAt(proxyVec[index].leaf);
+		}
+
+		// last proxy takes the place of the removed one
+		proxyVec[index] = proxyVec.back();
+		proxyVec.pop_back();
+		if(index == proxyVec.size())
+			return;
+		proxyMap[proxyVec[index].object] = index;
+		if(proxyVec[index].leaf >= 0)
+			nodeVec[proxyVec[index].leaf].proxy = index;
+	}
+
+	void DynamicAABBTree::clear()
+	{
+		root = -1;
+		freeNode = -1;
+		nodeVec.clear();
+		proxyVec.clear();
+		proxyMap.clear();
+	}
+
+	void DynamicAABBTree::findPairs(const std::vector<CollisionObject*>&, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs)
+	{
+		for(int i = 0; i < proxyVec.size(); ++i)
+			updateProxy(i, p_bounds[proxyVec[i].object->getIndex()]);
+
+		// each object looks for objects with a higher ID, so every pair is found once
+		for(int i = 0; i < proxyVec.size(); ++i) {
+			const Proxy &proxy = proxyVec[i];
+			if(proxy.leaf < 0)
+				continue;
+
+			stackVec.clear();
+			stackVec.push_back(root);
+			while(!stackVec.empty()) {
+				const Node &node = nodeVec[stackVec.back()];
+				stackVec.pop_back();
+				if(!node.bounds.overlaps(proxy.bounds))
+					continue;
+				if(!node.isLeaf()) {
+					stackVec.push_back(node.left);
+					stackVec.push_back(node.right);
+					continue;
+				}
+
+				const Proxy &other = proxyVec[node.proxy];
+				if(other.object->getID() > proxy.object->getID() && proxy.bounds.overlaps(other.bounds))
+					p_pairs.push_back(CollisionPair(proxy.object, other.object));
+			}
+		}
+
+		sortPairs(p_pairs);
+	}
+
+	void DynamicAABBTree::query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects)
+	{
+		if(root < 0)
+			return;
+
+		stackVec.clear();
+		stackVec.push_back(root);
+		while(!stackVec.empty()) {
+			const Node &node = nodeVec[stackVec.back()];
+			stackVec.pop_back();
+			if(!node.bounds.overlaps(p_bounds))
+				continue;
+			if(!node.isLeaf()) {
+				stackVec.push_back(node.left);
+				stackVec.push_back(node.right);
+				continue;
+			}
+
+			// leaves have fat bounds
+			const Proxy &proxy = proxyVec[node.proxy];
+			if(proxy.bounds.overlaps(p_bounds))
+				p_objects.push_back(proxy.object);
+		}
+	}
+}
@@ -0,0 +1,478 @@
+#include <cmath>
+#include <cfloat>
+#include "cdl/GJK.hpp"
+
+#define GJK_MAX_ITERATIONS 32
+#define EPA_MAX_ITERATIONS 32
+// relative progress towards the origin below which GJK stops
+#define GJK_TOLERANCE 1e-6f
+// absolute progress of the polytope below which EPA stops
+#define EPA_TOLERANCE 1e-4f
+
+namespace cdl
+{
+	/* A vertex of the simplex is a point of the Minkowski difference A - B.
+	 * The points of A and B it was created from are kept to calculate the
+	 * closest points of the shapes. */
+	class SimplexVertex
+	{
+	public:
+		Vec2 pointA;
+		Vec2 pointB;
+		Vec2 point;
+		float weight;
+	};
+
+	class Simplex
+	{
+	public:
+		SimplexVertex vertices[3];
+		int count;
+	};
+
+	ConvexShape::ConvexShape(const Circle &p_circle)
+	:vertices(localVertices), vertexCount(1), radius(p_circle.radius)
+	{
+		localVertices[0] = p_circle.mid;
+	}
+
+	ConvexShape::ConvexShape(const Polygon &p_polygon)
+	:vertices(p_polygon.corners.empty() ? localVertices : &p_polygon.corners[0]),
+	 vertexCount(p_polygon.corners.size()), radius(0)
+	{
+	}
+
+	ConvexShape::ConvexShape(const Line &p_lineSegment)
+	:vertices(localVertices), vertexCount(2), radius(0)
+	{
+		localVertices[0] = p_lineSegment.point1;
+		localVertices[1] = p_lineSegment.point2;
+	}
+
+	ConvexShape::ConvexShape(const ConvexShape &p_shape)
+	{
+		*this = p_shape;
+	}
+
+	ConvexShape& ConvexShape::operator=(const ConvexShape &p_shape)
+	{
+		// circles and line segments point to their own copy of the vertices
+		localVertices[0] = p_shape.localVertices[0];
+		localVertices[1] = p_shape.localVertices[1];
+		vertices = p_shape.vertices == p_shape.localVertices ? localVertices : p_shape.vertices;
+		vertexCount = p_shape.vertexCount;
+		radius = p_shape.radius;
+		offset = p_shape.offset;
+		return *this;
+	}
+
+	Vec2 ConvexShape::support(const Vec2 &p_direction) const
+	{
+		unsigned int best = 0;
+		float bestValue = dot(vertices[0], p_direction);
+		for(unsigned int i = 1; i < vertexCount; ++i) {
+			float value = dot(vertices[i], p_direction);
+			if(value > bestValue) {
+				bestValue = value;
+				best = i;
+			}
+		}
+		return vertices[best] + offset;
+	}
+
+	Vec2 ConvexShape::getVertex(const unsigned int p_index) const
+	{
+		return vertices[p_index] + offset;
+	}
+
+	unsigned int ConvexShape::getVertexCount() const
+	{
+		return vertexCount;
+	}
+
+	float ConvexShape::getRadius() const
+	{
+		return radius;
+	}
+
+	void ConvexShape::setOffset(const Vec2 &p_offset)
+	{
+		offset = p_offset;
+	}
+
+	const Vec2& ConvexShape::getOffset() const
+	{
+		return offset;
+	}
+
+	static SimplexVertex createVertex(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, const Vec2 &p_direction)
+	{
+		SimplexVertex result;
+		result.pointA = p_shapeA.support(p_direction);
+		result.pointB = p_shapeB.support(-1 * p_direction);
+		result.point = result.pointA - result.pointB;
+		result.weight = 1;
+		return result;
+	}
+
+	// reduces the simplex to the closest feature of the line segment to the origin
+	static void solve2(Simplex &p_simplex)
+	{
+		const Vec2 &w1 = p_simplex.vertices[0].point;
+		const Vec2 &w2 = p_simplex.vertices[1].point;
+		Vec2 e12 = w2 - w1;
+
+		float d12_2 = -dot(w1, e12);
+		if(d12_2 <= 0) {
+			p_simplex.vertices[0].weight = 1;
+			p_simplex.count = 1;
+			return;
+		}
+		float d12_1 = dot(w2, e12);
+		if(d12_1 <= 0) {
+			p_simplex.vertices[1].weight = 1;
+			p_simplex.vertices[0] = p_simplex.vertices[1];
+			p_simplex.count = 1;
+			return;
+		}
+
+		p_simplex.vertices[0].weight = d12_1 / (d12_1 + d12_2);
+		p_simplex.vertices[1].weight = d12_2 / (d12_1 + d12_2);
+	}
+
+	// reduces the simplex to the closest feature of the triangle to the origin
+	static void solve3(Simplex &p_simplex)
+	{
+		SimplexVertex *vertices = p_simplex.vertices;
+		const Vec2 &w1 = vertices[0].point;
+		const Vec2 &w2 = vertices[1].point;
+		const Vec2 &w3 = vertices[2].point;
+
+		Vec2 e12 = w2 - w1;
+		float d12_1 = dot(w2, e12);
+		float d12_2 = -dot(w1, e12);
+		Vec2 e13 = w3 - w1;
+		float d13_1 = dot(w3, e13);
+		float d13_2 = -dot(w1, e13);
+		Vec2 e23 = w3 - w2;
+		float d23_1 = dot(w3, e23);
+		float d23_2 = -dot(w2, e23);
+
+		float n123 = cross(e12, e13);
+		float d123_1 = n123 * cross(w2, w3);
+		float d123_2 = n123 * cross(w3, w1);
+		float d123_3 = n123 * cross(w1, w2);
+
+		// corner w1
+		if(d12_2 <= 0 && d13_2 <= 0) {
+			vertices[0].weight = 1;
+			p_simplex.count = 1;
+			return;
+		}
+		// edge w1 w2
+		if(d12_1 > 0 && d12_2 > 0 && d123_3 <= 0) {
+			vertices[0].weight = d12_1 / (d12_1 + d12_2);
+			vertices[1].weight = d12_2 / (d12_1 + d12_2);
+			p_simplex.count = 2;
+			return;
+		}
+		// edge w1 w3
+		if(d13_1 > 0 && d13_2 > 0 && d123_2 <= 0) {
+			vertices[0].weight = d13_1 / (d13_1 + d13_2);
+			vertices[2].weight = d13_2 / (d13_1 + d13_2);
+			vertices[1] = vertices[2];
+			p_simplex.count = 2;
+			return;
+		}
+		// corner w2
+		if(d12_1 <= 0 && d23_2 <= 0) {
+			vertices[1].weight = 1;
+			vertices[0] = vertices[1];
+			p_simplex.count = 1;
+			return;
+		}
+		// corner w3
+		if(d13_1 <= 0 && d23_1 <= 0) {
+			vertices[2].weight = 1;
+			vertices[0] = vertices[2];
+			p_simplex.count = 1;
+			return;
+		}
+		// edge w2 w3
+		if(d23_1 > 0 && d23_2 > 0 && d123_1 <= 0) {
+			vertices[1].weight = d23_1 / (d23_1 + d23_2);
+			vertices[2].weight = d23_2 / (d23_1 + d23_2);
+			vertices[0] = vertices[2];
+			p_simplex.count = 2;
+			return;
+		}
+
+		// origin is inside of the triangle
+		float sum = d123_1 + d123_2 + d123_3;
+		vertices[0].weight = d123_1 / sum;
+		vertices[1].weight = d123_2 / sum;
+		vertices[2].weight = d123_3 / sum;
+	}
+
+	static void solve(Simplex &p_simplex)
+	{
+		if(p_simplex.count == 1)
+			p_simplex.vertices[0].weight = 1;
+		else if(p_simplex.count == 2)
+			solve2(p_simplex);
+		else
+			solve3(p_simplex);
+	}
+
+	static Vec2 closestPoint(const Simplex &p_simplex)
+	{
+		Vec2 result;
+		for(int i = 0; i < p_simplex.count; ++i)
+			result += p_simplex.vertices[i].weight * p_simplex.vertices[i].point;
+		return result;
+	}
+
+	static void witnessPoints(const Simplex &p_simplex, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		p_pointA.set(0, 0);
+		p_pointB.set(0, 0);
+		for(int i = 0; i < p_simplex.count; ++i) {
+			p_pointA += p_simplex.vertices[i].weight * p_simplex.vertices[i].pointA;
+			p_pointB += p_simplex.vertices[i].weight * p_simplex.vertices[i].pointB;
+		}
+	}
+
+	// returns the distance of the shapes without their radius, 0 if they overlap
+	static float runGJK(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, Simplex &p_simplex)
+	{
+		// all vertices have to be support points, EPA relies on them being
+		// on the border of the Minkowski difference
+		Vec2 direction = p_shapeA.getVertex(0) - p_shapeB.getVertex(0);
+		if(direction.lengthSQ() == 0)
+			direction.set(1, 0);
+		p_simplex.count = 1;
+		p_simplex.vertices[0] = createVertex(p_shapeA, p_shapeB, direction);
+
+		for(int iteration = 0; iteration < GJK_MAX_ITERATIONS; ++iteration) {
+			solve(p_simplex);
+			if(p_simplex.count == 3)
+				return 0;
+
+			Vec2 closest = closestPoint(p_simplex);
+			float sqDistance = closest.lengthSQ();
+			if(sqDistance <= FLT_EPSILON * FLT_EPSILON)
+				return 0;
+
+			SimplexVertex vertex = createVertex(p_shapeA, p_shapeB, -1 * closest);
+			// vertex is already in simplex, no closer point exists
+			bool duplicate = false;
+			for(int i = 0; i < p_simplex.count; ++i) {
+				if(p_simplex.vertices[i].pointA == vertex.pointA && p_simplex.vertices[i].pointB == vertex.pointB)
+					duplicate = true;
+			}
+			// new vertex is not significantly closer to the origin
+			if(duplicate || sqDistance - dot(vertex.point, closest) <= GJK_TOLERANCE * sqDistance)
+				return sqrt(sqDistance);
+
+			p_simplex.vertices[p_simplex.count++] = vertex;
+		}
+
+		solve(p_simplex);
+		if(p_simplex.count == 3)
+			return 0;
+		return closestPoint(p_simplex).length();
+	}
+
+	/* Expands the simplex containing the origin to the edge of the Minkowski
+	 * difference closest to the origin. The normal of this edge points from
+	 * shape A to shape B and its distance is the penetration depth. */
+	static bool runEPA(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, const Simplex &p_simplex, Vec2 &p_normal, float &p_depth, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		SimplexVertex polytope[EPA_MAX_ITERATIONS + 3];
+		int count = p_simplex.count;
+		for(int i = 0; i < count; ++i)
+			polytope[i] = p_simplex.vertices[i];
+
+		// shapes only touch, grow the simplex to a triangle
+		const Vec2 directions[4] = { Vec2(1, 0), Vec2(-1, 0), Vec2(0, 1), Vec2(0, -1) };
+		for(int i = 0; i < 4 && count == 1; ++i) {
+			polytope[1] = createVertex(p_shapeA, p_shapeB, directions[i]);
+			if(polytope[1].point != polytope[0].point)
+				count = 2;
+		}
+		if(count == 2) {
+			Vec2 perpendicular = (polytope[1].point - polytope[0].point).perpendicular();
+			polytope[2] = createVertex(p_shapeA, p_shapeB, perpendicular);
+			if(dot(polytope[2].point - polytope[0].point, perpendicular) <= 0)
+				polytope[2] = createVertex(p_shapeA, p_shapeB, -1 * perpendicular);
+			// Minkowski difference has no area
+			if(cross(polytope[1].point - polytope[0].point, polytope[2].point - polytope[0].point) == 0)
+				return false;
+			count = 3;
+		}
+		if(count < 3)
+			return false;
+
+		// keep polytope counter-clockwise, so edge normals point outside
+		if(cross(polytope[1].point - polytope[0].point, polytope[2].point - polytope[0].point) < 0) {
+			SimplexVertex tmp = polytope[1];
+			polytope[1] = polytope[2];
+			polytope[2] = tmp;
+		}
+
+		int closestEdge = 0;
+		for(int iteration = 0; iteration < EPA_MAX_ITERATIONS; ++iteration) {
+			// find edge closest to the origin
+			p_depth = FLT_MAX;
+			for(int i = 0; i < count; ++i) {
+				Vec2 edge = polytope[(i + 1) % count].point - polytope[i].point;
+				Vec2 normal(edge.y, -edge.x);
+				float length = normal.length();
+				if(length == 0)
+					continue;
+				normal /= length;
+				float distance = dot(normal, polytope[i].point);
+				if(distance < p_depth) {
+					p_depth = distance;
+					p_normal = normal;
+					closestEdge = i;
+				}
+			}
+
+			// edge is on the border of the Minkowski difference
+			SimplexVertex vertex = createVertex(p_shapeA, p_shapeB, p_normal);
+			if(dot(vertex.point, p_normal) - p_depth < EPA_TOLERANCE)
+				break;
+
+			for(int i = count; i > closestEdge + 1; --i)
+				polytope[i] = polytope[i - 1];
+			polytope[closestEdge + 1] = vertex;
+			++count;
+		}
+
+		// closest points are interpolated along the closest edge
+		const SimplexVertex &vertex1 = polytope[closestEdge];
+		const SimplexVertex &vertex2 = polytope[(closestEdge + 1) % count];
+		Vec2 edge = vertex2.point - vertex1.point;
+		float u = edge.lengthSQ() > 0 ? -dot(vertex1.point, edge) / edge.lengthSQ() : 0;
+		if(u < 0)
+			u = 0;
+		else if(u > 1)
+			u = 1;
+		p_pointA = vertex1.pointA + (u * (vertex2.pointA - vertex1.pointA));
+		p_pointB = vertex1.pointB + (u * (vertex2.pointB - vertex1.pointB));
+		return true;
+	}
+
+	float gjkDistance(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		Simplex simplex;
+		float distance = runGJK(p_shapeA, p_shapeB, simplex);
+		witnessPoints(simplex, p_pointA, p_pointB);
+
+		float radiusSum = p_shapeA.getRadius() + p_shapeB.getRadius();
+		if(distance <= radiusSum) {
+			// shapes overlap, there are no closest points
+			p_pointA = 0.5f * (p_pointA + p_pointB);
+			p_pointB = p_pointA;
+			return 0;
+		}
+
+		// move closest points of the mids to the border of the circles
+		Vec2 normal = (p_pointB - p_pointA) / distance;
+		p_pointA += p_shapeA.getRadius() * normal;
+		p_pointB -= p_shapeB.getRadius() * normal;
+		return distance - radiusSum;
+	}
+
+	bool gjkIntersect(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB)
+	{
+		Simplex simplex;
+		return runGJK(p_shapeA, p_shapeB, simplex) <= p_shapeA.getRadius() + p_shapeB.getRadius();
+	}
+
+	bool gjkCollide(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, ContactManifold &p_manifold)
+	{
+		Simplex simplex;
+		Vec2 pointA, pointB;
+		float radiusA = p_shapeA.getRadius();
+		float radiusB = p_shapeB.getRadius();
+		float distance = runGJK(p_shapeA, p_shapeB, simplex);
+		if(distance > radiusA + radiusB)
+			return false;
+
+		if(distance > 0) {
+			// only the radii overlap
+			witnessPoints(simplex, pointA, pointB);
+			p_manifold.normal = (pointB - pointA) / distance;
+			p_manifold.penetration = radiusA + radiusB - distance;
+		} else if(runEPA(p_shapeA, p_shapeB, simplex, p_manifold.normal, p_manifold.penetration, pointA, pointB)) {
+			p_manifold.penetration += radiusA + radiusB;
+		} else {
+			// shapes overlap on a line, there is no unique normal
+			witnessPoints(simplex, pointA, pointB);
+			p_manifold.normal.set(1, 0);
+			p_manifold.penetration = radiusA + radiusB;
+		}
+
+		// contact is in the middle of both borders
+		pointA += radiusA * p_manifold.normal;
+		pointB -= radiusB * p_manifold.normal;
+		p_manifold.points[0] = 0.5f * (pointA + pointB);
+		p_manifold.pointCount = 1;
+		return true;
+	}
+
+	static void updateDistance(const ConvexShape &p_shapeA, const ConvexShape &p_shapeB, float &p_distance, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		Vec2 pointA, pointB;
+		float distance = gjkDistance(p_shapeA, p_shapeB, pointA, pointB);
+		if(distance < p_distance) {
+			p_distance = distance;
+			p_pointA = pointA;
+			p_pointB = pointB;
+		}
+	}
+
+	// smallest distance of a shape to all shapes of an object
+	static void distanceToObject(const ConvexShape &p_shape, const CollisionObject &p_object, float &p_distance, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+
+		for(int i = 0; i < circles.size(); ++i)
+			updateDistance(p_shape, ConvexShape(circles[i]), p_distance, p_pointA, p_pointB);
+
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(p_object.isPolygonConvex(i)) {
+				updateDistance(p_shape, ConvexShape(polygons[i]), p_distance, p_pointA, p_pointB);
+				continue;
+			}
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j)
+				updateDistance(p_shape, ConvexShape(Line(corners[j], corners[(j + 1) % corners.size()])), p_distance, p_pointA, p_pointB);
+		}
+	}
+
+	float gjkDistance(const CollisionObject &p_objectA, const CollisionObject &p_objectB, Vec2 &p_pointA, Vec2 &p_pointB)
+	{
+		float result = FLT_MAX;
+		const std::vector<Circle> &circles = p_objectA.worldCircles();
+		const std::vector<Polygon> &polygons = p_objectA.worldPolygons();
+
+		for(int i = 0; i < circles.size(); ++i)
+			distanceToObject(ConvexShape(circles[i]), p_objectB, result, p_pointA, p_pointB);
+
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(p_objectA.isPolygonConvex(i)) {
+				distanceToObject(ConvexShape(polygons[i]), p_objectB, result, p_pointA, p_pointB);
+				continue;
+			}
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j)
+				distanceToObject(ConvexShape(Line(corners[j], corners[(j + 1) % corners.size()])), p_objectB, result, p_pointA, p_pointB);
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,92 @@
+#include "cdl/ObjectPool.hpp"
+
+// number of objects allocated at once
+#define OBJECT_BLOCK_SIZE 64
+
+namespace cdl
+{
+	ObjectPool::~ObjectPool()
+	{
+		for(int i = 0; i < blockVec.size(); ++i)
+			delete[] blockVec[i];
+	}
+	
+	void ObjectPool::addBlock()
+	{
+		CollisionObject *block = new CollisionObject[OBJECT_BLOCK_SIZE];
+		blockVec.push_back(block);
+		
+		// lowest slot is on top of the free list
+		unsigned int firstSlot = slotVec.size();
+		for(unsigned int i = 0; i < OBJECT_BLOCK_SIZE; ++i) {
+			block[i].handle = ObjectHandle(firstSlot + i, 0);
+			slotVec.push_back(&block[i]);
+			generationVec.push_back(1);
+		}
+		for(unsigned int i = OBJECT_BLOCK_SIZE; i > 0; --i)
+			freeSlotVec.push_back(firstSlot + i - 1);
+	}
+	
+	bool ObjectPool::isUsed(const unsigned int p_slot) const
+	{
+		// handle of an object only gets the generation of its slot while it exists
+		return slotVec[p_slot]->handle.generation == generationVec[p_slot];
+	}
+	
+	CollisionObject* ObjectPool::create(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles)
+	{
+		if(freeSlotVec.empty())
+			addBlock();
+		
+		unsigned int slot = freeSlotVec.back();
+		freeSlotVec.pop_back();
+		
+		CollisionObject *result = slotVec[slot];
+		result->reset(p_polygons, p_circles);
+		result->handle = ObjectHandle(slot, generationVec[slot]);
+		++objectCount;
+		return result;
+	}
+	
+	void ObjectPool::destroy(CollisionObject *p_object)
+	{
+		if(!contains(p_object))
+			return;
+		
+		unsigned int slot = p_object->handle.slot;
+		++generationVec[slot];
+		freeSlotVec.push_back(slot);
+		--objectCount;
+	}
+	
+	void ObjectPool::clear()
+	{
+		freeSlotVec.clear();
+		for(unsigned int i = slotVec.size(); i > 0; --i) {
+			if(isUsed(i - 1))
+				++generationVec[i - 1];
+			freeSlotVec.push_back(i - 1);
+		}
+		objectCount = 0;
+	}
+	
+	bool ObjectPool::contains(const CollisionObject *p_object) const
+	{
+		if(p_object == NULL)
+			return false;
+		unsigned int slot = p_object->handle.slot;
+		return slot < slotVec.size() && slotVec[slot] == p_object && isUsed(slot);
+	}
+	
+	CollisionObject* ObjectPool::get(const ObjectHandle &p_handle) const
+	{
+		if(p_handle.slot >= slotVec.size() || generationVec[p_handle.slot] != p_handle.generation || !isUsed(p_handle.slot))
+			return NULL;
+		return slotVec[p_handle.slot];
+	}
+	
+	unsigned int ObjectPool::size() const
+	{
+		return objectCount;
+	}
+}
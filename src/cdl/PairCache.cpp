@@ -0,0 +1,60 @@
+#include <algorithm>
+#include "cdl/PairCache.hpp"
+
+namespace cdl
+{
+	static bool compareKeys(const PairCache::Entry &p_entry1, const PairCache::Entry &p_entry2)
+	{
+		return p_entry1.key < p_entry2.key;
+	}
+
+	void PairCache::nextIteration()
+	{
+		++stamp;
+	}
+
+	PairCache::Entry& PairCache::visit(CollisionObject *p_objectA, CollisionObject *p_objectB)
+	{
+		// key is sorted the same way as the pairs, object with lower ID first
+		unsigned long long idA = p_objectA->getID();
+		unsigned long long idB = p_objectB->getID();
+		unsigned long long key = idA < idB ? (idA << 32) | idB : (idB << 32) | idA;
+
+		Entry &result = entryMap[key];
+		if(result.key != key) {
+			result.key = key;
+			result.handleA = idA < idB ? p_objectA->getHandle() : p_objectB->getHandle();
+			result.handleB = idA < idB ? p_objectB->getHandle() : p_objectA->getHandle();
+		}
+		result.stamp = stamp;
+		return result;
+	}
+
+	void PairCache::findUnvisited(std::vector<Entry> &p_unvisited) const
+	{
+		unsigned int first = p_unvisited.size();
+		std::unordered_map<unsigned long long, Entry>::const_iterator it;
+		for(it = entryMap.begin(); it != entryMap.end(); ++it) {
+			if(it->second.stamp != stamp)
+				p_unvisited.push_back(it->second);
+		}
+
+		// order of the map is arbitrary, keep results deterministic
+		std::sort(p_unvisited.begin() + first, p_unvisited.end(), compareKeys);
+	}
+
+	void PairCache::remove(const Entry &p_entry)
+	{
+		entryMap.erase(p_entry.key);
+	}
+
+	void PairCache::clear()
+	{
+		entryMap.clear();
+	}
+
+	unsigned int PairCache::size() const
+	{
+		return entryMap.size();
+	}
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cmath>
+#include "cdl/Raycast.hpp"
+#include "cdl/CollisionDetection.hpp"
+#include "cdl/ContinuousCollision.hpp"
+
+// distance the shape is moved back from the contact to find the normal
+#define CAST_BACKOFF 1e-2f
+
+namespace cdl
+{
+	// normal of a ray that starts inside of a shape
+	static Vec2 againstRay(const Vec2 &p_direction)
+	{
+		float length = p_direction.length();
+		if(length == 0)
+			return Vec2(0, 0);
+		return p_direction / -length;
+	}
+
+	bool raycastCircle(const Line &p_ray, const Circle &p_circle, float &p_fraction, Vec2 &p_normal)
+	{
+		// solve |start + direction * t - mid| = radius
+		Vec2 direction = p_ray.point2 - p_ray.point1;
+		Vec2 distance = p_ray.point1 - p_circle.mid;
+		float c = dot(distance, distance) - p_circle.radius * p_circle.radius;
+		if(c <= 0) {
+			p_fraction = 0;
+			p_normal = againstRay(direction);
+			return true;
+		}
+
+		float a = dot(direction, direction);
+		float b = dot(distance, direction);
+		// ray starts outside and points away
+		if(a == 0 || b >= 0)
+			return false;
+		float discriminant = b * b - a * c;
+		if(discriminant < 0)
+			return false;
+
+		float fraction = (-b - sqrt(discriminant)) / a;
+		if(fraction > 1)
+			return false;
+		p_fraction = fraction;
+		p_normal = (distance + fraction * direction) / p_circle.radius;
+		return true;
+	}
+
+	bool raycastPolygon(const Line &p_ray, const Polygon &p_polygon, float &p_fraction, Vec2 &p_normal)
+	{
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		Vec2 direction = p_ray.point2 - p_ray.point1;
+		if(corners.size() > 2 && overlapPointPolygon(p_ray.point1, p_polygon)) {
+			p_fraction = 0;
+			p_normal = againstRay(direction);
+			return true;
+		}
+
+		// closest crossing of the ray with an edge
+		bool hit = false;
+		for(int i = 0; i < corners.size(); ++i) {
+			const Vec2 &corner = corners[i];
+			Vec2 edge = corners[(i + 1) % corners.size()] - corner;
+			float denominator = cross(direction, edge);
+			if(denominator == 0)
+				continue;
+
+			float fraction = cross(corner - p_ray.point1, edge) / denominator;
+			float edgeFraction = cross(corner - p_ray.point1, direction) / denominator;
+			if(fraction < 0 || fraction > 1 || edgeFraction < 0 || edgeFraction > 1 || (hit && fraction >= p_fraction))
+				continue;
+
+			Vec2 normal = edge.perpendicular() / edge.length();
+			p_normal = dot(normal, direction) > 0 ? -1 * normal : normal;
+			p_fraction = fraction;
+			hit = true;
+		}
+		return hit;
+	}
+
+	bool raycastObject(const Line &p_ray, const CollisionObject &p_object, RaycastHit &p_hit)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+		float fraction;
+		Vec2 normal;
+		bool hit = false;
+
+		for(int i = 0; i < circles.size(); ++i) {
+			if(raycastCircle(p_ray, circles[i], fraction, normal) && (!hit || fraction < p_hit.fraction)) {
+				p_hit.fraction = fraction;
+				p_hit.normal = normal;
+				hit = true;
+			}
+		}
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(raycastPolygon(p_ray, polygons[i], fraction, normal) && (!hit || fraction < p_hit.fraction)) {
+				p_hit.fraction = fraction;
+				p_hit.normal = normal;
+				hit = true;
+			}
+		}
+
+		if(hit) {
+			p_hit.object = const_cast<CollisionObject*>(&p_object);
+			p_hit.point = p_ray.point1 + p_hit.fraction * (p_ray.point2 - p_ray.point1);
+		}
+		return hit;
+	}
+
+	bool castShape(const ConvexShape &p_shape, const Vec2 &p_translation, const ConvexShape &p_target, float &p_fraction, Vec2 &p_point, Vec2 &p_normal)
+	{
+		// translation is the velocity of a sweep that takes one second
+		float fraction;
+		if(!sweepConvexShapes(p_target, Vec2(0, 0), p_shape, p_translation, 1, fraction))
+			return false;
+
+		// closest points of shapes that almost touch give an unstable normal
+		float length = p_translation.length();
+		float backoff = length > 0 ? std::min(fraction, CAST_BACKOFF / length) : 0;
+		ConvexShape shape(p_shape);
+		shape.setOffset(p_shape.getOffset() + (fraction - backoff) * p_translation);
+		Vec2 pointTarget, pointShape;
+		gjkDistance(p_target, shape, pointTarget, pointShape);
+		Vec2 normal = pointShape - pointTarget;
+		if(normal != Vec2(0, 0)) {
+			p_point = pointTarget;
+			p_normal = normal / normal.length();
+		} else {
+			// shapes already overlap at the start
+			ContactManifold manifold;
+			if(!gjkCollide(p_target, shape, manifold))
+				return false;
+			p_point = manifold.points[0];
+			p_normal = manifold.normal;
+		}
+		p_fraction = fraction;
+		return true;
+	}
+
+	static void castShapeConvex(const ConvexShape &p_shape, const Vec2 &p_translation, const ConvexShape &p_target, bool &p_hit, RaycastHit &p_result)
+	{
+		float fraction;
+		Vec2 point, normal;
+		if(castShape(p_shape, p_translation, p_target, fraction, point, normal) && (!p_hit || fraction < p_result.fraction)) {
+			p_result.fraction = fraction;
+			p_result.point = point;
+			p_result.normal = normal;
+			p_hit = true;
+		}
+	}
+
+	bool castShapeObject(const ConvexShape &p_shape, const Vec2 &p_translation, const CollisionObject &p_object, RaycastHit &p_hit)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+		bool hit = false;
+
+		for(int i = 0; i < circles.size(); ++i)
+			castShapeConvex(p_shape, p_translation, ConvexShape(circles[i]), hit, p_hit);
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(p_object.isPolygonConvex(i)) {
+				castShapeConvex(p_shape, p_translation, ConvexShape(polygons[i]), hit, p_hit);
+				continue;
+			}
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j)
+				castShapeConvex(p_shape, p_translation, ConvexShape(Line(corners[j], corners[(j + 1) % corners.size()])), hit, p_hit);
+		}
+
+		if(hit)
+			p_hit.object = const_cast<CollisionObject*>(&p_object);
+		return hit;
+	}
+}
@@ -0,0 +1,53 @@
+#include "cdl/RegionQuery.hpp"
+#include "cdl/CollisionDetection.hpp"
+
+namespace cdl
+{
+	Polygon polygonOf(const AABB &p_bounds)
+	{
+		Polygon result;
+		result.corners.push_back(Vec2(p_bounds.min.x, p_bounds.max.y));
+		result.corners.push_back(p_bounds.max);
+		result.corners.push_back(Vec2(p_bounds.max.x, p_bounds.min.y));
+		result.corners.push_back(p_bounds.min);
+		return result;
+	}
+
+	bool overlapObjectCircle(const CollisionObject &p_object, const Circle &p_circle)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+		const std::vector<AABB> &circleBounds = p_object.worldCircleBounds();
+		const std::vector<AABB> &polygonBounds = p_object.worldPolygonBounds();
+		AABB bounds = boundsOf(p_circle);
+
+		for(int i = 0; i < circles.size(); ++i) {
+			if(bounds.overlaps(circleBounds[i]) && overlapCircles(p_circle, circles[i]))
+				return true;
+		}
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(bounds.overlaps(polygonBounds[i]) && overlapCirclePolygon(p_circle, polygons[i]))
+				return true;
+		}
+		return false;
+	}
+
+	bool overlapObjectPolygon(const CollisionObject &p_object, const Polygon &p_polygon)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+		const std::vector<AABB> &circleBounds = p_object.worldCircleBounds();
+		const std::vector<AABB> &polygonBounds = p_object.worldPolygonBounds();
+		AABB bounds = boundsOf(p_polygon);
+
+		for(int i = 0; i < circles.size(); ++i) {
+			if(bounds.overlaps(circleBounds[i]) && overlapCirclePolygon(circles[i], p_polygon))
+				return true;
+		}
+		for(int i = 0; i < polygons.size(); ++i) {
+			if(bounds.overlaps(polygonBounds[i]) && overlapPolygons(p_polygon, polygons[i]))
+				return true;
+		}
+		return false;
+	}
+}
@@ -0,0 +1,252 @@
+#include <cmath>
+#include <cfloat>
+#include "cdl/SeparatingAxis.hpp"
+
+// reference face is only switched if the other face separates clearly more
+#define REFERENCE_FACE_TOLERANCE 1e-4f
+
+namespace cdl
+{
+	static bool isCounterClockwise(const std::vector<Vec2> &p_corners)
+	{
+		float area = 0;
+		for(int i = 0; i < p_corners.size(); ++i)
+			area += cross(p_corners[i], p_corners[(i + 1) % p_corners.size()]);
+		return area > 0;
+	}
+
+	// normal of the edge from corner p_index to the next corner, pointing outside
+	static Vec2 edgeNormal(const std::vector<Vec2> &p_corners, const int p_index, const bool p_ccw)
+	{
+		Vec2 edge = p_corners[(p_index + 1) % p_corners.size()] - p_corners[p_index];
+		return normalize(p_ccw ? Vec2(edge.y, -edge.x) : Vec2(-edge.y, edge.x));
+	}
+
+	/* Returns the largest distance of polygon2 to an edge of polygon1. A
+	 * positive distance means the edge is a separating axis. The deepest
+	 * corner of polygon2 only moves a little from one edge to the next, so it
+	 * is tracked instead of being searched for every edge. */
+	static float findMaxSeparation(const std::vector<Vec2> &p_corners1, const bool p_ccw1, const std::vector<Vec2> &p_corners2, int &p_edge)
+	{
+		int count2 = p_corners2.size();
+		int support = 0;
+		float maxSeparation = -FLT_MAX;
+
+		for(int i = 0; i < p_corners1.size(); ++i) {
+			Vec2 normal = edgeNormal(p_corners1, i, p_ccw1);
+			if(i == 0) {
+				for(int j = 1; j < count2; ++j) {
+					if(dot(normal, p_corners2[j]) < dot(normal, p_corners2[support]))
+						support = j;
+				}
+			} else {
+				// projections of a convex polygon have only one minimum
+				while(dot(normal, p_corners2[(support + 1) % count2]) < dot(normal, p_corners2[support]))
+					support = (support + 1) % count2;
+				while(dot(normal, p_corners2[(support + count2 - 1) % count2]) < dot(normal, p_corners2[support]))
+					support = (support + count2 - 1) % count2;
+			}
+
+			float separation = dot(normal, p_corners2[support] - p_corners1[i]);
+			if(separation > maxSeparation) {
+				maxSeparation = separation;
+				p_edge = i;
+				// found separating axis
+				if(separation > 0)
+					break;
+			}
+		}
+
+		return maxSeparation;
+	}
+
+	// keeps the part of the segment that is behind the plane given by normal and offset
+	static int clipSegment(const Vec2 p_in[2], Vec2 p_out[3], const Vec2 &p_normal, const float p_offset)
+	{
+		int count = 0;
+		float distance1 = dot(p_normal, p_in[0]) - p_offset;
+		float distance2 = dot(p_normal, p_in[1]) - p_offset;
+
+		if(distance1 <= 0)
+			p_out[count++] = p_in[0];
+		if(distance2 <= 0)
+			p_out[count++] = p_in[1];
+		// points are on different sides, add intersection with the plane
+		if(distance1 * distance2 < 0)
+			p_out[count++] = p_in[0] + ((distance1 / (distance1 - distance2)) * (p_in[1] - p_in[0]));
+
+		return count;
+	}
+
+	bool isConvex(const Polygon &p_polygon)
+	{
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		if(corners.size() < 3)
+			return false;
+
+		// all corners have to turn in the same direction
+		bool hasLeftTurn = false;
+		bool hasRightTurn = false;
+		for(int i = 0; i < corners.size(); ++i) {
+			Vec2 edge1 = corners[(i + 1) % corners.size()] - corners[i];
+			Vec2 edge2 = corners[(i + 2) % corners.size()] - corners[(i + 1) % corners.size()];
+			float turn = cross(edge1, edge2);
+			if(turn > 0)
+				hasLeftTurn = true;
+			else if(turn < 0)
+				hasRightTurn = true;
+		}
+
+		return hasLeftTurn != hasRightTurn;
+	}
+
+	bool collideCircles(const Circle &p_circle1, const Circle &p_circle2, ContactManifold &p_manifold)
+	{
+		Vec2 directionVec = p_circle2.mid - p_circle1.mid;
+		float radiusSum = p_circle1.radius + p_circle2.radius;
+		float sqDistance = directionVec.lengthSQ();
+		if(sqDistance > radiusSum * radiusSum)
+			return false;
+
+		float distance = sqrt(sqDistance);
+		// mids are equal, any direction separates the circles
+		p_manifold.normal = distance > 0 ? directionVec / distance : Vec2(1, 0);
+		p_manifold.penetration = radiusSum - distance;
+		p_manifold.points[0] = p_circle1.mid + (p_manifold.normal * (p_circle1.radius - p_manifold.penetration / 2));
+		p_manifold.pointCount = 1;
+		return true;
+	}
+
+	bool collideCircleConvexPolygon(const Circle &p_circle, const Polygon &p_polygon, ContactManifold &p_manifold)
+	{
+		const std::vector<Vec2> &corners = p_polygon.corners;
+		if(corners.size() < 3)
+			return false;
+		bool ccw = isCounterClockwise(corners);
+
+		// find edge with largest distance to the mid of the circle
+		int edge = 0;
+		float maxSeparation = -FLT_MAX;
+		for(int i = 0; i < corners.size(); ++i) {
+			float separation = dot(edgeNormal(corners, i, ccw), p_circle.mid - corners[i]);
+			if(separation > p_circle.radius)
+				return false;
+			if(separation > maxSeparation) {
+				maxSeparation = separation;
+				edge = i;
+			}
+		}
+
+		const Vec2 &corner1 = corners[edge];
+		const Vec2 &corner2 = corners[(edge + 1) % corners.size()];
+		Vec2 normal = edgeNormal(corners, edge, ccw);
+		Vec2 contact;
+
+		if(maxSeparation > 0 && dot(p_circle.mid - corner1, corner2 - corner1) <= 0) {
+			// mid is outside near corner1
+			Vec2 diff = p_circle.mid - corner1;
+			if(diff.lengthSQ() > p_circle.radius * p_circle.radius)
+				return false;
+			float distance = diff.length();
+			normal = distance > 0 ? diff / distance : normal;
+			maxSeparation = distance;
+			contact = corner1;
+		} else if(maxSeparation > 0 && dot(p_circle.mid - corner2, corner1 - corner2) <= 0) {
+			// mid is outside near corner2
+			Vec2 diff = p_circle.mid - corner2;
+			if(diff.lengthSQ() > p_circle.radius * p_circle.radius)
+				return false;
+			float distance = diff.length();
+			normal = distance > 0 ? diff / distance : normal;
+			maxSeparation = distance;
+			contact = corner2;
+		} else {
+			// mid is in front of the edge or inside of the polygon
+			contact = p_circle.mid - (maxSeparation * normal);
+		}
+
+		// normal points from polygon to circle, manifold normal from circle to polygon
+		p_manifold.normal = -1 * normal;
+		p_manifold.penetration = p_circle.radius - maxSeparation;
+		p_manifold.points[0] = contact;
+		p_manifold.pointCount = 1;
+		return true;
+	}
+
+	bool collideConvexPolygons(const Polygon &p_polygon1, const Polygon &p_polygon2, ContactManifold &p_manifold)
+	{
+		if(p_polygon1.corners.size() < 3 || p_polygon2.corners.size() < 3)
+			return false;
+		bool ccw1 = isCounterClockwise(p_polygon1.corners);
+		bool ccw2 = isCounterClockwise(p_polygon2.corners);
+
+		int edge1 = 0;
+		float separation1 = findMaxSeparation(p_polygon1.corners, ccw1, p_polygon2.corners, edge1);
+		if(separation1 > 0)
+			return false;
+		int edge2 = 0;
+		float separation2 = findMaxSeparation(p_polygon2.corners, ccw2, p_polygon1.corners, edge2);
+		if(separation2 > 0)
+			return false;
+
+		// edge with the least penetration is the reference face
+		bool flip = separation2 > separation1 + REFERENCE_FACE_TOLERANCE;
+		const std::vector<Vec2> &reference = flip ? p_polygon2.corners : p_polygon1.corners;
+		const std::vector<Vec2> &incident = flip ? p_polygon1.corners : p_polygon2.corners;
+		int referenceEdge = flip ? edge2 : edge1;
+		Vec2 referenceNormal = edgeNormal(reference, referenceEdge, flip ? ccw2 : ccw1);
+		bool incidentCcw = flip ? ccw1 : ccw2;
+
+		// incident edge is the one most opposite to the reference normal
+		int incidentEdge = 0;
+		float minDot = FLT_MAX;
+		for(int i = 0; i < incident.size(); ++i) {
+			float normalDot = dot(referenceNormal, edgeNormal(incident, i, incidentCcw));
+			if(normalDot < minDot) {
+				minDot = normalDot;
+				incidentEdge = i;
+			}
+		}
+
+		// clip incident edge to the side planes of the reference edge
+		const Vec2 &reference1 = reference[referenceEdge];
+		const Vec2 &reference2 = reference[(referenceEdge + 1) % reference.size()];
+		Vec2 tangent = reference2 - reference1;
+		tangent /= tangent.length();
+		Vec2 incidentPoints[2] = { incident[incidentEdge], incident[(incidentEdge + 1) % incident.size()] };
+		Vec2 clipped1[3], clipped2[3];
+		int clipCount = clipSegment(incidentPoints, clipped1, -1 * tangent, -dot(tangent, reference1));
+		if(clipCount == 1)
+			clipped1[1] = clipped1[0];
+		if(clipCount > 0)
+			clipCount = clipSegment(clipped1, clipped2, tangent, dot(tangent, reference2));
+		if(clipCount == 1)
+			clipped2[1] = clipped2[0];
+		
+		// keep points behind the reference face
+		p_manifold.pointCount = 0;
+		p_manifold.penetration = 0;
+		for(int i = 0; i < 2 && clipCount > 0; ++i) {
+			float separation = dot(referenceNormal, clipped2[i] - reference1);
+			if(separation <= 0 && (i == 0 || p_manifold.pointCount == 0 || clipped2[i] != p_manifold.points[0])) {
+				p_manifold.points[p_manifold.pointCount++] = clipped2[i];
+				if(-separation > p_manifold.penetration)
+					p_manifold.penetration = -separation;
+			}
+		}
+		
+		// incident edge is beside the reference edge, use deepest corner
+		if(p_manifold.pointCount == 0) {
+			int deepest = 0;
+			for(int i = 1; i < incident.size(); ++i) {
+				if(dot(referenceNormal, incident[i]) < dot(referenceNormal, incident[deepest]))
+					deepest = i;
+			}
+			p_manifold.points[p_manifold.pointCount++] = incident[deepest];
+			p_manifold.penetration = -dot(referenceNormal, incident[deepest] - reference1);
+		}
+		p_manifold.normal = flip ? -1 * referenceNormal : referenceNormal;
+
+		return true;
+	}
+}
@@ -0,0 +1,137 @@
+#include <cmath>
+#include "cdl/SpatialHashGrid.hpp"
+
+namespace cdl
+{
+	void SpatialHashGrid::setCellSize(const float p_cellSize)
+	{
+		cellSize = p_cellSize;
+	}
+
+	float SpatialHashGrid::getCellSize() const
+	{
+		return cellSize;
+	}
+
+	int SpatialHashGrid::cellCoord(const float p_value) const
+	{
+		return (int) floor(p_value / cellSize);
+	}
+
+	unsigned int SpatialHashGrid::hashCell(const int p_cellX, const int p_cellY) const
+	{
+		// bucket count is always a power of 2
+		unsigned int mask = bucketStartVec.size() - 2;
+		return ((((unsigned int) p_cellX) * 73856093u) ^ (((unsigned int) p_cellY) * 19349663u)) & mask;
+	}
+
+	void SpatialHashGrid::findPairs(const std::vector<CollisionObject*> &p_objects, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs)
+	{
+		objectVec.clear();
+		boundsVec.clear();
+		entryVec.clear();
+
+		// insert every object in each cell its bounds touch
+		for(int i = 0; i < p_objects.size(); ++i) {
+			const AABB &bounds = p_bounds[i];
+			if(bounds.isEmpty())
+				continue;
+
+			CellEntry entry;
+			entry.index = objectVec.size();
+			objectVec.push_back(p_objects[i]);
+			boundsVec.push_back(bounds);
+
+			int maxX = cellCoord(bounds.max.x);
+			int maxY = cellCoord(bounds.max.y);
+			for(entry.cellX = cellCoord(bounds.min.x); entry.cellX <= maxX; ++entry.cellX) {
+				for(entry.cellY = cellCoord(bounds.min.y); entry.cellY <= maxY; ++entry.cellY)
+					entryVec.push_back(entry);
+			}
+		}
+
+		// sort entries into buckets by hash of their cell (counting sort)
+		unsigned int bucketCount = 1;
+		while(bucketCount < entryVec.size())
+			bucketCount *= 2;
+		bucketStartVec.assign(bucketCount + 1, 0);
+		for(int i = 0; i < entryVec.size(); ++i)
+			++bucketStartVec[hashCell(entryVec[i].cellX, entryVec[i].cellY)];
+		for(int i = 1; i <= bucketCount; ++i)
+			bucketStartVec[i] += bucketStartVec[i - 1];
+		bucketEntryVec.resize(entryVec.size());
+		for(int i = entryVec.size() - 1; i >= 0; --i)
+			bucketEntryVec[--bucketStartVec[hashCell(entryVec[i].cellX, entryVec[i].cellY)]] = entryVec[i];
+
+		// check all objects within the same cell
+		for(int bucket = 0; bucket < bucketCount; ++bucket) {
+			for(int i = bucketStartVec[bucket]; i < bucketStartVec[bucket + 1]; ++i) {
+				const CellEntry &entryA = bucketEntryVec[i];
+				for(int j = i + 1; j < bucketStartVec[bucket + 1]; ++j) {
+					const CellEntry &entryB = bucketEntryVec[j];
+					// different cells can share a bucket
+					if(entryA.cellX != entryB.cellX || entryA.cellY != entryB.cellY)
+						continue;
+
+					const AABB &boundsA = boundsVec[entryA.index];
+					const AABB &boundsB = boundsVec[entryB.index];
+					if(!boundsA.overlaps(boundsB))
+						continue;
+
+					// objects can share several cells, only report the pair in the
+					// cell that contains the minimum of the overlapping area
+					float overlapX = boundsA.min.x > boundsB.min.x ? boundsA.min.x : boundsB.min.x;
+					float overlapY = boundsA.min.y > boundsB.min.y ? boundsA.min.y : boundsB.min.y;
+					if(cellCoord(overlapX) != entryA.cellX || cellCoord(overlapY) != entryA.cellY)
+						continue;
+
+					CollisionObject *objectA = objectVec[entryA.index];
+					CollisionObject *objectB = objectVec[entryB.index];
+					if(objectA->getID() < objectB->getID())
+						p_pairs.push_back(CollisionPair(objectA, objectB));
+					else
+						p_pairs.push_back(CollisionPair(objectB, objectA));
+				}
+			}
+		}
+
+		sortPairs(p_pairs);
+	}
+
+	void SpatialHashGrid::query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects)
+	{
+		if(objectVec.empty())
+			return;
+
+		// a region with more cells than objects is faster checked against every object
+		int minX = cellCoord(p_bounds.min.x);
+		int minY = cellCoord(p_bounds.min.y);
+		int maxX = cellCoord(p_bounds.max.x);
+		int maxY = cellCoord(p_bounds.max.y);
+		if(((double) maxX - minX + 1) * ((double) maxY - minY + 1) > objectVec.size()) {
+			for(int i = 0; i < objectVec.size(); ++i) {
+				if(boundsVec[i].overlaps(p_bounds))
+					p_objects.push_back(objectVec[i]);
+			}
+			return;
+		}
+
+		for(int cellX = minX; cellX <= maxX; ++cellX) {
+			for(int cellY = minY; cellY <= maxY; ++cellY) {
+				unsigned int bucket = hashCell(cellX, cellY);
+				for(int i = bucketStartVec[bucket]; i < bucketStartVec[bucket + 1]; ++i) {
+					const CellEntry &entry = bucketEntryVec[i];
+					const AABB &bounds = boundsVec[entry.index];
+					if(entry.cellX != cellX || entry.cellY != cellY || !bounds.overlaps(p_bounds))
+						continue;
+
+					// like pairs, an object is only reported in the cell with the minimum of the overlap
+					float overlapX = bounds.min.x > p_bounds.min.x ? bounds.min.x : p_bounds.min.x;
+					float overlapY = bounds.min.y > p_bounds.min.y ? bounds.min.y : p_bounds.min.y;
+					if(cellCoord(overlapX) == cellX && cellCoord(overlapY) == cellY)
+						p_objects.push_back(objectVec[entry.index]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,457 @@
+#include <algorithm>
+#include "cdl/StaticBVH.hpp"
+
+#define BVH_BIN_COUNT 16
+#define BVH_LEAF_SIZE 4
+// deeper nodes become leaves, which bounds the stack of a query
+#define BVH_MAX_DEPTH 48
+// smaller trees are not worth building in parallel
+#define BVH_PARALLEL_MIN_COUNT 256
+// refit trees are rebuilt once their nodes are this much larger than after the build
+#define BVH_MAX_REFIT_COST 2.0f
+
+namespace cdl
+{
+	// builds the subtrees below the first levels, one subtree per task
+	class StaticBVH::BuildTask : public ThreadPool::Task
+	{
+	private:
+		StaticBVH &tree;
+	public:
+		BuildTask(StaticBVH &p_tree): tree(p_tree) { }
+		~BuildTask() { }
+
+		void execute(const unsigned int, const unsigned int p_index)
+		{
+			Subtree &subtree = tree.subtreeVec[p_index];
+			subtree.nodeVec.resize(1);
+			tree.buildNode(subtree.nodeVec, 0, subtree.start, subtree.count, subtree.depth, BVH_MAX_DEPTH);
+		}
+	};
+
+	/* Checks if a box with the given half extents hits the bounds while it
+	 * moves along the direction. Returns the fraction at which it enters. */
+	static bool castBounds(const Vec2 &p_start, const Vec2 &p_direction, const Vec2 &p_extent, const AABB &p_bounds, const float p_maxFraction, float &p_fraction)
+	{
+		float enter = 0;
+		float exit = p_maxFraction;
+		float starts[2] = { p_start.x, p_start.y };
+		float directions[2] = { p_direction.x, p_direction.y };
+		float mins[2] = { p_bounds.min.x - p_extent.x, p_bounds.min.y - p_extent.y };
+		float maxs[2] = { p_bounds.max.x + p_extent.x, p_bounds.max.y + p_extent.y };
+
+		for(int i = 0; i < 2; ++i) {
+			if(directions[i] == 0) {
+				if(starts[i] < mins[i] || starts[i] > maxs[i])
+					return false;
+				continue;
+			}
+			float nearFraction = (mins[i] - starts[i]) / directions[i];
+			float farFraction = (maxs[i] - starts[i]) / directions[i];
+			if(nearFraction > farFraction)
+				std::swap(nearFraction, farFraction);
+			enter = std::max(enter, nearFraction);
+			exit = std::min(exit, farFraction);
+			if(enter > exit)
+				return false;
+		}
+		p_fraction = enter;
+		return true;
+	}
+
+	static bool isCloser(const RaycastHit &p_hit, const RaycastHit &p_closest, const bool p_found)
+	{
+		return !p_found || p_hit.fraction < p_closest.fraction || (p_hit.fraction == p_closest.fraction && p_hit.object->getID() < p_closest.object->getID());
+	}
+
+	static float halfPerimeter(const AABB &p_bounds)
+	{
+		if(p_bounds.isEmpty())
+			return 0;
+		return (p_bounds.max.x - p_bounds.min.x) + (p_bounds.max.y - p_bounds.min.y);
+	}
+
+	void StaticBVH::addPrimitives(CollisionObject *p_object)
+	{
+		const std::vector<Circle> &circles = p_object->worldCircles();
+		const std::vector<AABB> &circleBounds = p_object->worldCircleBounds();
+		const std::vector<AABB> &polygonBounds = p_object->worldPolygonBounds();
+
+		Primitive primitive;
+		primitive.object = p_object;
+		primitive.circle = true;
+		for(int i = 0; i < circles.size(); ++i) {
+			primitive.shape = i;
+			primitive.bounds = circleBounds[i];
+			primitive.mid = circles[i].mid;
+			primitiveVec.push_back(primitive);
+		}
+		primitive.circle = false;
+		for(int i = 0; i < polygonBounds.size(); ++i) {
+			if(polygonBounds[i].isEmpty())
+				continue;
+			primitive.shape = i;
+			primitive.bounds = polygonBounds[i];
+			primitive.mid = 0.5f * (polygonBounds[i].min + polygonBounds[i].max);
+			primitiveVec.push_back(primitive);
+		}
+	}
+
+	void StaticBVH::build(const std::vector<CollisionObject*> &p_objects, ThreadPool *p_threadPool)
+	{
+		clear();
+		for(int i = 0; i < p_objects.size(); ++i)
+			addPrimitives(p_objects[i]);
+		if(primitiveVec.empty())
+			return;
+
+		// first levels are built here, about four subtrees per thread are left for the pool
+		unsigned int splitDepth = BVH_MAX_DEPTH;
+		if(p_threadPool != NULL && primitiveVec.size() >= BVH_PARALLEL_MIN_COUNT) {
+			splitDepth = 2;
+			while((1u << splitDepth) < 4 * p_threadPool->getThreadCount())
+				++splitDepth;
+		}
+
+		nodeVec.resize(1);
+		buildNode(nodeVec, 0, 0, primitiveVec.size(), 0, splitDepth);
+		if(!subtreeVec.empty()) {
+			BuildTask task(*this);
+			p_threadPool->run(subtreeVec.size(), task);
+			for(int i = 0; i < subtreeVec.size(); ++i)
+				spliceSubtree(subtreeVec[i]);
+			subtreeVec.clear();
+		}
+		buildCost = getCost();
+	}
+
+	void StaticBVH::buildNode(std::vector<Node> &p_nodes, const unsigned int p_node, const unsigned int p_start, const unsigned int p_count, const unsigned int p_depth, const unsigned int p_splitDepth)
+	{
+		AABB bounds;
+		for(unsigned int i = p_start; i < p_start + p_count; ++i)
+			bounds.merge(primitiveVec[i].bounds);
+		p_nodes[p_node].bounds = bounds;
+		p_nodes[p_node].first = p_start;
+		p_nodes[p_node].count = p_count;
+
+		unsigned int leftCount;
+		if(p_count <= BVH_LEAF_SIZE || p_depth >= BVH_MAX_DEPTH || !splitPrimitives(p_start, p_count, bounds, leftCount))
+			return;
+
+		// subtree is left to the thread pool, its node is filled in later
+		if(p_depth >= p_splitDepth) {
+			Subtree subtree;
+			subtree.node = p_node;
+			subtree.start = p_start;
+			subtree.count = p_count;
+			subtree.depth = p_depth;
+			subtreeVec.push_back(subtree);
+			return;
+		}
+
+		unsigned int children = p_nodes.size();
+		p_nodes.resize(children + 2);
+		p_nodes[p_node].first = children;
+		p_nodes[p_node].count = 0;
+		buildNode(p_nodes, children, p_start, leftCount, p_depth + 1, p_splitDepth);
+		buildNode(p_nodes, children + 1, p_start + leftCount, p_count - leftCount, p_depth + 1, p_splitDepth);
+	}
+
+	bool StaticBVH::splitPrimitives(const unsigned int p_start, const unsigned int p_count, const AABB &p_bounds, unsigned int &p_leftCount)
+	{
+		AABB midBounds;
+		for(unsigned int i = p_start; i < p_start + p_count; ++i)
+			midBounds.merge(primitiveVec[i].mid);
+
+		// split along the longest axis of the mids
+		bool axisX = midBounds.max.x - midBounds.min.x >= midBounds.max.y - midBounds.min.y;
+		float min = axisX ? midBounds.min.x : midBounds.min.y;
+		float extent = axisX ? midBounds.max.x - midBounds.min.x : midBounds.max.y - midBounds.min.y;
+		if(extent <= 0)
+			return false;
+
+		AABB binBounds[BVH_BIN_COUNT];
+		unsigned int binCounts[BVH_BIN_COUNT] = { 0 };
+		float scale = BVH_BIN_COUNT / extent;
+		for(unsigned int i = p_start; i < p_start + p_count; ++i) {
+			const Primitive &primitive = primitiveVec[i];
+			int bin = std::min((int) (((axisX ? primitive.mid.x : primitive.mid.y) - min) * scale), BVH_BIN_COUNT - 1);
+			++binCounts[bin];
+			binBounds[bin].merge(primitive.bounds);
+		}
+
+		// cost of every split is the number of primitives times the perimeter of each side
+		float rightCosts[BVH_BIN_COUNT];
+		AABB rightBounds;
+		unsigned int rightCount = 0;
+		for(int i = BVH_BIN_COUNT - 1; i > 0; --i) {
+			rightBounds.merge(binBounds[i]);
+			rightCount += binCounts[i];
+			rightCosts[i] = rightCount * halfPerimeter(rightBounds);
+		}
+
+		AABB leftBounds;
+		unsigned int leftCount = 0;
+		float bestCost = p_count * halfPerimeter(p_bounds);
+		int bestSplit = -1;
+		for(int i = 0; i < BVH_BIN_COUNT - 1; ++i) {
+			leftBounds.merge(binBounds[i]);
+			leftCount += binCounts[i];
+			float cost = leftCount * halfPerimeter(leftBounds) + rightCosts[i + 1];
+			if(leftCount > 0 && leftCount < p_count && cost < bestCost) {
+				bestCost = cost;
+				bestSplit = i;
+			}
+		}
+		if(bestSplit < 0)
+			return false;
+
+		p_leftCount = 0;
+		for(int i = 0; i <= bestSplit; ++i)
+			p_leftCount += binCounts[i];
+
+		std::vector<Primitive>::iterator begin = primitiveVec.begin() + p_start;
+		std::vector<Primitive>::iterator end = begin + p_count;
+		for(std::vector<Primitive>::iterator it = begin; it != end; ++it) {
+			int bin = std::min((int) (((axisX ? it->mid.x : it->mid.y) - min) * scale), BVH_BIN_COUNT - 1);
+			if(bin <= bestSplit)
+				std::iter_swap(it, begin++);
+		}
+		return true;
+	}
+
+	void StaticBVH::spliceSubtree(const Subtree &p_subtree)
+	{
+		// root takes the place of the waiting node, all other nodes are appended
+		unsigned int offset = nodeVec.size() - 1;
+		nodeVec.insert(nodeVec.end(), p_subtree.nodeVec.begin() + 1, p_subtree.nodeVec.end());
+		nodeVec[p_subtree.node] = p_subtree.nodeVec[0];
+		if(nodeVec[p_subtree.node].count == 0)
+			nodeVec[p_subtree.node].first += offset;
+		for(unsigned int i = offset + 1; i < nodeVec.size(); ++i) {
+			if(nodeVec[i].count == 0)
+				nodeVec[i].first += offset;
+		}
+	}
+
+	float StaticBVH::getCost() const
+	{
+		// queries visit nodes about in proportion to their perimeters
+		float cost = 0;
+		for(int i = 0; i < nodeVec.size(); ++i)
+			cost += halfPerimeter(nodeVec[i].bounds);
+		return cost;
+	}
+
+	bool StaticBVH::refit()
+	{
+		for(int i = 0; i < primitiveVec.size(); ++i) {
+			Primitive &primitive = primitiveVec[i];
+			if(primitive.circle)
+				primitive.bounds = primitive.object->worldCircleBounds()[primitive.shape];
+			else
+				primitive.bounds = primitive.object->worldPolygonBounds()[primitive.shape];
+		}
+
+		// children are always stored behind their parent
+		for(int i = nodeVec.size() - 1; i >= 0; --i) {
+			Node &node = nodeVec[i];
+			node.bounds = AABB();
+			if(node.count == 0) {
+				node.bounds.merge(nodeVec[node.first].bounds);
+				node.bounds.merge(nodeVec[node.first + 1].bounds);
+				continue;
+			}
+			for(unsigned int j = node.first; j < node.first + node.count; ++j)
+				node.bounds.merge(primitiveVec[j].bounds);
+		}
+		return getCost() <= BVH_MAX_REFIT_COST * buildCost;
+	}
+
+	void StaticBVH::clear()
+	{
+		primitiveVec.clear();
+		nodeVec.clear();
+		subtreeVec.clear();
+		buildCost = 0;
+	}
+
+	void StaticBVH::query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects) const
+	{
+		if(nodeVec.empty())
+			return;
+
+		unsigned int stack[BVH_MAX_DEPTH + 2];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while(stackSize > 0) {
+			const Node &node = nodeVec[stack[--stackSize]];
+			if(!node.bounds.overlaps(p_bounds))
+				continue;
+
+			if(node.count == 0) {
+				stack[stackSize++] = node.first + 1;
+				stack[stackSize++] = node.first;
+				continue;
+			}
+
+			for(unsigned int i = node.first; i < node.first + node.count; ++i) {
+				if(primitiveVec[i].bounds.overlaps(p_bounds))
+					p_objects.push_back(primitiveVec[i].object);
+			}
+		}
+	}
+
+	bool StaticBVH::raycastPrimitive(const Primitive &p_primitive, const Line &p_ray, RaycastHit &p_hit) const
+	{
+		bool hit;
+		if(p_primitive.circle)
+			hit = raycastCircle(p_ray, p_primitive.object->worldCircles()[p_primitive.shape], p_hit.fraction, p_hit.normal);
+		else
+			hit = raycastPolygon(p_ray, p_primitive.object->worldPolygons()[p_primitive.shape], p_hit.fraction, p_hit.normal);
+		if(!hit)
+			return false;
+		p_hit.object = p_primitive.object;
+		p_hit.point = p_ray.point1 + p_hit.fraction * (p_ray.point2 - p_ray.point1);
+		return true;
+	}
+
+	bool StaticBVH::castShapePrimitive(const Primitive &p_primitive, const ConvexShape &p_shape, const Vec2 &p_translation, RaycastHit &p_hit) const
+	{
+		const CollisionObject &object = *p_primitive.object;
+		p_hit.object = p_primitive.object;
+		if(p_primitive.circle)
+			return cdl::castShape(p_shape, p_translation, ConvexShape(object.worldCircles()[p_primitive.shape]), p_hit.fraction, p_hit.point, p_hit.normal);
+
+		const Polygon &polygon = object.worldPolygons()[p_primitive.shape];
+		if(object.isPolygonConvex(p_primitive.shape))
+			return cdl::castShape(p_shape, p_translation, ConvexShape(polygon), p_hit.fraction, p_hit.point, p_hit.normal);
+
+		// concave polygons are handled as their edges
+		RaycastHit edgeHit;
+		bool hit = false;
+		for(int i = 0; i < polygon.corners.size(); ++i) {
+			Line edge(polygon.corners[i], polygon.corners[(i + 1) % polygon.corners.size()]);
+			if(cdl::castShape(p_shape, p_translation, ConvexShape(edge), edgeHit.fraction, edgeHit.point, edgeHit.normal) && (!hit || edgeHit.fraction < p_hit.fraction)) {
+				p_hit.fraction = edgeHit.fraction;
+				p_hit.point = edgeHit.point;
+				p_hit.normal = edgeHit.normal;
+				hit = true;
+			}
+		}
+		return hit;
+	}
+
+	bool StaticBVH::raycast(const Line &p_ray, RaycastHit &p_hit) const
+	{
+		if(nodeVec.empty())
+			return false;
+
+		Vec2 direction = p_ray.point2 - p_ray.point1;
+		RaycastHit hit;
+		bool found = false;
+		float fraction;
+		unsigned int stack[BVH_MAX_DEPTH + 2];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while(stackSize > 0) {
+			const Node &node = nodeVec[stack[--stackSize]];
+			// nodes behind the closest hit cannot contain a closer one
+			if(!castBounds(p_ray.point1, direction, Vec2(0, 0), node.bounds, found ? p_hit.fraction : 1, fraction))
+				continue;
+
+			if(node.count == 0) {
+				stack[stackSize++] = node.first + 1;
+				stack[stackSize++] = node.first;
+				continue;
+			}
+
+			for(unsigned int i = node.first; i < node.first + node.count; ++i) {
+				if(!castBounds(p_ray.point1, direction, Vec2(0, 0), primitiveVec[i].bounds, found ? p_hit.fraction : 1, fraction))
+					continue;
+				if(raycastPrimitive(primitiveVec[i], p_ray, hit) && isCloser(hit, p_hit, found)) {
+					p_hit = hit;
+					found = true;
+				}
+			}
+		}
+		return found;
+	}
+
+	void StaticBVH::raycastAll(const Line &p_ray, std::vector<RaycastHit> &p_hits) const
+	{
+		if(nodeVec.empty())
+			return;
+
+		Vec2 direction = p_ray.point2 - p_ray.point1;
+		RaycastHit hit;
+		float fraction;
+		unsigned int stack[BVH_MAX_DEPTH + 2];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while(stackSize > 0) {
+			const Node &node = nodeVec[stack[--stackSize]];
+			if(!castBounds(p_ray.point1, direction, Vec2(0, 0), node.bounds, 1, fraction))
+				continue;
+
+			if(node.count == 0) {
+				stack[stackSize++] = node.first + 1;
+				stack[stackSize++] = node.first;
+				continue;
+			}
+
+			// one hit per shape, objects with several shapes may be hit more than once
+			for(unsigned int i = node.first; i < node.first + node.count; ++i) {
+				if(castBounds(p_ray.point1, direction, Vec2(0, 0), primitiveVec[i].bounds, 1, fraction) && raycastPrimitive(primitiveVec[i], p_ray, hit))
+					p_hits.push_back(hit);
+			}
+		}
+	}
+
+	bool StaticBVH::castShape(const ConvexShape &p_shape, const AABB &p_bounds, const Vec2 &p_translation, RaycastHit &p_hit) const
+	{
+		if(nodeVec.empty() || p_bounds.isEmpty())
+			return false;
+
+		// the bounds of the shape move like a ray from their mid
+		Vec2 start = 0.5f * (p_bounds.min + p_bounds.max);
+		Vec2 extent = 0.5f * (p_bounds.max - p_bounds.min);
+		RaycastHit hit;
+		bool found = false;
+		float fraction;
+		unsigned int stack[BVH_MAX_DEPTH + 2];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while(stackSize > 0) {
+			const Node &node = nodeVec[stack[--stackSize]];
+			if(!castBounds(start, p_translation, extent, node.bounds, found ? p_hit.fraction : 1, fraction))
+				continue;
+
+			if(node.count == 0) {
+				stack[stackSize++] = node.first + 1;
+				stack[stackSize++] = node.first;
+				continue;
+			}
+
+			for(unsigned int i = node.first; i < node.first + node.count; ++i) {
+				if(!castBounds(start, p_translation, extent, primitiveVec[i].bounds, found ? p_hit.fraction : 1, fraction))
+					continue;
+				if(castShapePrimitive(primitiveVec[i], p_shape, p_translation, hit) && isCloser(hit, p_hit, found)) {
+					p_hit = hit;
+					found = true;
+				}
+			}
+		}
+		return found;
+	}
+
+	bool StaticBVH::empty() const
+	{
+		return nodeVec.empty();
+	}
+
+	unsigned int StaticBVH::getNodeCount() const
+	{
+		return nodeVec.size();
+	}
+}
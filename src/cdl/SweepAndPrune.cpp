@@ -0,0 +1,174 @@
+#include "cdl/SweepAndPrune.hpp"
+
+// proxy of an endpoint whose object was removed
+#define REMOVED_PROXY 0xffffffffu
+
+namespace cdl
+{
+	void SweepAndPrune::setAxis(const Axis p_axis)
+	{
+		// endpoints are re-sorted in next step
+		axis = p_axis;
+	}
+
+	SweepAndPrune::Axis SweepAndPrune::getAxis() const
+	{
+		return axis;
+	}
+
+	void SweepAndPrune::addObject(CollisionObject *p_object)
+	{
+		Proxy proxy;
+		proxy.object = p_object;
+		proxy.minEndpoint = endpointVec.size();
+		proxy.maxEndpoint = endpointVec.size() + 1;
+		proxyVec.push_back(proxy);
+		proxyMap[p_object] = proxyVec.size() - 1;
+
+		// values are set in next step
+		Endpoint endpoint;
+		endpoint.value = 0;
+		endpoint.proxy = proxyVec.size() - 1;
+		endpoint.isMin = true;
+		endpointVec.push_back(endpoint);
+		endpoint.isMin = false;
+		endpointVec.push_back(endpoint);
+	}
+
+	void SweepAndPrune::removeObject(CollisionObject *p_object)
+	{
+		std::unordered_map<CollisionObject*, unsigned int>::iterator it = proxyMap.find(p_object);
+		if(it == proxyMap.end())
+			return;
+
+		// endpoints are only marked, they are dropped before the next sort
+		unsigned int index = it->second;
+		proxyMap.erase(it);
+		endpointVec[proxyVec[index].minEndpoint].proxy = REMOVED_PROXY;
+		endpointVec[proxyVec[index].maxEndpoint].proxy = REMOVED_PROXY;
+		endpointsRemoved = true;
+
+		// last proxy takes the place of the removed one
+		proxyVec[index] = proxyVec.back();
+		proxyVec.pop_back();
+		if(index == proxyVec.size())
+			return;
+		proxyMap[proxyVec[index].object] = index;
+		endpointVec[proxyVec[index].minEndpoint].proxy = index;
+		endpointVec[proxyVec[index].maxEndpoint].proxy = index;
+	}
+
+	void SweepAndPrune::clear()
+	{
+		proxyVec.clear();
+		proxyMap.clear();
+		endpointVec.clear();
+		endpointsRemoved = false;
+	}
+
+	void SweepAndPrune::removeEndpoints()
+	{
+		if(!endpointsRemoved)
+			return;
+
+		unsigned int count = 0;
+		for(int i = 0; i < endpointVec.size(); ++i) {
+			if(endpointVec[i].proxy != REMOVED_PROXY)
+				endpointVec[count++] = endpointVec[i];
+		}
+		endpointVec.resize(count);
+		endpointsRemoved = false;
+	}
+
+	void SweepAndPrune::updateEndpoints(const std::vector<AABB> &p_bounds)
+	{
+		for(int i = 0; i < proxyVec.size(); ++i)
+			proxyVec[i].bounds = p_bounds[proxyVec[i].object->getIndex()];
+
+		for(int i = 0; i < endpointVec.size(); ++i) {
+			const AABB &bounds = proxyVec[endpointVec[i].proxy].bounds;
+			const Vec2 &point = endpointVec[i].isMin ? bounds.min : bounds.max;
+			endpointVec[i].value = axis == AXIS_X ? point.x : point.y;
+		}
+	}
+
+	void SweepAndPrune::sortEndpoints()
+	{
+		// endpoints are almost sorted from last step, insertion sort is nearly linear
+		for(int i = 1; i < endpointVec.size(); ++i) {
+			Endpoint endpoint = endpointVec[i];
+			int j = i - 1;
+			while(j >= 0 && endpoint < endpointVec[j]) {
+				endpointVec[j + 1] = endpointVec[j];
+				--j;
+			}
+			endpointVec[j + 1] = endpoint;
+		}
+
+		// proxies remember where their endpoints ended up
+		for(int i = 0; i < endpointVec.size(); ++i) {
+			Proxy &proxy = proxyVec[endpointVec[i].proxy];
+			if(endpointVec[i].isMin)
+				proxy.minEndpoint = i;
+			else
+				proxy.maxEndpoint = i;
+		}
+	}
+
+	void SweepAndPrune::findPairs(const std::vector<CollisionObject*>&, const std::vector<AABB> &p_bounds, std::vector<CollisionPair> &p_pairs)
+	{
+		removeEndpoints();
+		updateEndpoints(p_bounds);
+		sortEndpoints();
+
+		// sweep along the axis, all active objects overlap on this axis
+		activeVec.clear();
+		for(int i = 0; i < endpointVec.size(); ++i) {
+			unsigned int proxy = endpointVec[i].proxy;
+			const AABB &bounds = proxyVec[proxy].bounds;
+			// objects without shapes have empty bounds
+			if(bounds.isEmpty())
+				continue;
+
+			if(!endpointVec[i].isMin) {
+				for(int j = 0; j < activeVec.size(); ++j) {
+					if(activeVec[j] == proxy) {
+						activeVec[j] = activeVec.back();
+						activeVec.pop_back();
+						break;
+					}
+				}
+				continue;
+			}
+
+			for(int j = 0; j < activeVec.size(); ++j) {
+				if(!bounds.overlaps(proxyVec[activeVec[j]].bounds))
+					continue;
+
+				CollisionObject *objectA = proxyVec[proxy].object;
+				CollisionObject *objectB = proxyVec[activeVec[j]].object;
+				if(objectA->getID() < objectB->getID())
+					p_pairs.push_back(CollisionPair(objectA, objectB));
+				else
+					p_pairs.push_back(CollisionPair(objectB, objectA));
+			}
+			activeVec.push_back(proxy);
+		}
+
+		sortPairs(p_pairs);
+	}
+
+	void SweepAndPrune::query(const AABB &p_bounds, std::vector<CollisionObject*> &p_objects)
+	{
+		// objects that start behind the region cannot touch it, all others are checked
+		float max = axis == AXIS_X ? p_bounds.max.x : p_bounds.max.y;
+		for(int i = 0; i < endpointVec.size() && endpointVec[i].value <= max; ++i) {
+			const Endpoint &endpoint = endpointVec[i];
+			if(!endpoint.isMin || endpoint.proxy == REMOVED_PROXY)
+				continue;
+			const Proxy &proxy = proxyVec[endpoint.proxy];
+			if(!proxy.bounds.isEmpty() && proxy.bounds.overlaps(p_bounds))
+				p_objects.push_back(proxy.object);
+		}
+	}
+}
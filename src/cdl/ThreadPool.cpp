@@ -0,0 +1,114 @@
+#include "cdl/ThreadPool.hpp"
+
+namespace cdl
+{
+	ThreadPool::ThreadPool(const unsigned int p_threadCount)
+	:task(NULL), job(0), busyWorkers(0), stopping(false)
+	{
+		unsigned int threadCount = p_threadCount > 0 ? p_threadCount : 1;
+		for(unsigned int i = 0; i < threadCount; ++i)
+			queueVec.push_back(new WorkQueue());
+		// calling thread is worker 0
+		for(unsigned int i = 1; i < threadCount; ++i)
+			threadVec.push_back(std::thread(&ThreadPool::work, this, i));
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		jobCondition.notify_all();
+		for(int i = 0; i < threadVec.size(); ++i)
+			threadVec[i].join();
+		for(int i = 0; i < queueVec.size(); ++i)
+			delete queueVec[i];
+	}
+
+	unsigned int ThreadPool::getThreadCount() const
+	{
+		return queueVec.size();
+	}
+
+	void ThreadPool::run(const unsigned int p_taskCount, Task &p_task)
+	{
+		unsigned int workerCount = queueVec.size();
+		// every worker starts with an equal share
+		for(unsigned int i = 0; i < workerCount; ++i) {
+			std::lock_guard<std::mutex> lock(queueVec[i]->mutex);
+			queueVec[i]->begin = (unsigned int) (((unsigned long long) p_taskCount * i) / workerCount);
+			queueVec[i]->end = (unsigned int) (((unsigned long long) p_taskCount * (i + 1)) / workerCount);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			task = &p_task;
+			busyWorkers = workerCount - 1;
+			++job;
+		}
+		jobCondition.notify_all();
+
+		executeTasks(0);
+
+		// the other workers may still execute their last task
+		std::unique_lock<std::mutex> lock(mutex);
+		while(busyWorkers > 0)
+			doneCondition.wait(lock);
+		task = NULL;
+	}
+
+	void ThreadPool::work(const unsigned int p_worker)
+	{
+		unsigned int lastJob = 0;
+		while(true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				while(!stopping && job == lastJob)
+					jobCondition.wait(lock);
+				if(stopping)
+					return;
+				lastJob = job;
+			}
+
+			executeTasks(p_worker);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--busyWorkers;
+			}
+			doneCondition.notify_one();
+		}
+	}
+
+	void ThreadPool::executeTasks(const unsigned int p_worker)
+	{
+		unsigned int index;
+		while(popTask(p_worker, index) || stealTask(p_worker, index))
+			task->execute(p_worker, index);
+	}
+
+	bool ThreadPool::popTask(const unsigned int p_worker, unsigned int &p_index)
+	{
+		WorkQueue &queue = *queueVec[p_worker];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(queue.begin >= queue.end)
+			return false;
+		p_index = queue.begin++;
+		return true;
+	}
+
+	bool ThreadPool::stealTask(const unsigned int p_worker, unsigned int &p_index)
+	{
+		// other end of the queue than its owner, they rarely meet
+		for(unsigned int i = 1; i < queueVec.size(); ++i) {
+			WorkQueue &queue = *queueVec[(p_worker + i) % queueVec.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if(queue.begin < queue.end) {
+				p_index = --queue.end;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -1,93 +1,1005 @@
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <chrono>
 #include "cdl/World.hpp"
 #include "cdl/CollisionDetection.hpp"
+#include "cdl/SeparatingAxis.hpp"
+#include "cdl/GJK.hpp"
+#include "cdl/ContinuousCollision.hpp"
+#include "cdl/ThreadPool.hpp"
+
+// number of pairs a worker tests at once
+#define PAIR_CHUNK_SIZE 32
+// number of rays a worker casts at once
+#define RAY_CHUNK_SIZE 64
+
+// measuring is removed completely unless CDL_PROFILING is defined
+#ifdef CDL_PROFILING
+	#define CDL_PROFILE_BEGIN(p_name) std::chrono::steady_clock::time_point p_name = std::chrono::steady_clock::now()
+	#define CDL_PROFILE_END(p_name, p_seconds) p_seconds += std::chrono::duration<float>(std::chrono::steady_clock::now() - p_name).count()
+	#define CDL_PROFILE_COUNT(p_counter, p_value) p_counter += p_value
+	#define CDL_PROFILE_SHAPE_TEST() shapeTestCount.fetch_add(1, std::memory_order_relaxed)
+#else
+	#define CDL_PROFILE_BEGIN(p_name)
+	#define CDL_PROFILE_END(p_name, p_seconds)
+	#define CDL_PROFILE_COUNT(p_counter, p_value)
+	#define CDL_PROFILE_SHAPE_TEST()
+#endif
 
 namespace cdl
 {
+	// tests a chunk of the candidate pairs, the results are merged by the calling thread
+	class World::PairTask : public ThreadPool::Task
+	{
+	private:
+		World &world;
+	public:
+		PairTask(World &p_world): world(p_world) { }
+		~PairTask() { }
+		
+		void execute(const unsigned int p_worker, const unsigned int p_index)
+		{
+			std::vector<Vec2> &points = world.workerPointVec[p_worker];
+			unsigned int end = (p_index + 1) * PAIR_CHUNK_SIZE;
+			if(end > world.pairVec.size())
+				end = world.pairVec.size();
+			
+			for(unsigned int i = p_index * PAIR_CHUNK_SIZE; i < end; ++i) {
+				PairResult &result = world.pairResultVec[i];
+				result.worker = p_worker;
+				result.pointStart = points.size();
+				result.collided = world.testObjects(world.pairVec[i].objectA, world.pairVec[i].objectB, points);
+				if(!result.collided)
+					points.resize(result.pointStart);
+				result.pointCount = points.size() - result.pointStart;
+			}
+		}
+	};
+	
+	// sweeps a chunk of the candidate pairs, objects are moved by the calling thread
+	class World::SweepTask : public ThreadPool::Task
+	{
+	private:
+		World &world;
+		float sec;
+	public:
+		SweepTask(World &p_world, const float p_sec): world(p_world), sec(p_sec) { }
+		~SweepTask() { }
+		
+		void execute(const unsigned int, const unsigned int p_index)
+		{
+			unsigned int end = std::min((p_index + 1) * PAIR_CHUNK_SIZE, (unsigned int) world.pairVec.size());
+			for(unsigned int i = p_index * PAIR_CHUNK_SIZE; i < end; ++i) {
+				SweepResult &result = world.sweepResultVec[i];
+				result.hit = cdl::sweepObjects(*world.pairVec[i].objectA, *world.pairVec[i].objectB, sec, result.time, result.point);
+			}
+		}
+	};
+	
+	// casts a chunk of a batch of rays, every ray has its own hit
+	class World::RaycastTask : public ThreadPool::Task
+	{
+	private:
+		const StaticBVH &tree;
+		const std::vector<Line> &rays;
+		std::vector<RaycastHit> &hits;
+	public:
+		RaycastTask(const StaticBVH &p_tree, const std::vector<Line> &p_rays, std::vector<RaycastHit> &p_hits): tree(p_tree), rays(p_rays), hits(p_hits) { }
+		~RaycastTask() { }
+		
+		void execute(const unsigned int, const unsigned int p_index)
+		{
+			unsigned int end = std::min((p_index + 1) * RAY_CHUNK_SIZE, (unsigned int) rays.size());
+			for(unsigned int i = p_index * RAY_CHUNK_SIZE; i < end; ++i) {
+				if(!tree.raycast(rays[i], hits[i]))
+					hits[i] = RaycastHit();
+			}
+		}
+	};
+	
+	// hits of the same object are next to each other, the closest first
+	static bool compareObjectHits(const RaycastHit &p_hit1, const RaycastHit &p_hit2)
+	{
+		if(p_hit1.object != p_hit2.object)
+			return p_hit1.object->getID() < p_hit2.object->getID();
+		return p_hit1.fraction < p_hit2.fraction;
+	}
+	
+	static bool compareHitFractions(const RaycastHit &p_hit1, const RaycastHit &p_hit2)
+	{
+		if(p_hit1.fraction != p_hit2.fraction)
+			return p_hit1.fraction < p_hit2.fraction;
+		return p_hit1.object->getID() < p_hit2.object->getID();
+	}
+	
+	static bool compareObjectIDs(const CollisionObject *p_object1, const CollisionObject *p_object2)
+	{
+		return p_object1->getID() < p_object2->getID();
+	}
+	
+	World::~World()
+	{
+		delete threadPool;
+	}
+	
 	CollisionObject* World::createObject(const std::vector<Polygon> &p_polygons, const std::vector<Circle> &p_circles)
 	{
-		CollisionObject *result = new CollisionObject(p_polygons, p_circles);
-		objects.push_back(result);
+		CollisionObject *result = objectPool.create(p_polygons, p_circles);
+		result->id = nextID++;
+		result->index = objectVec.size();
+		objectVec.push_back(result);
+		queryTreeDirty = true;
+		queryTreeRebuild = true;
+		broadphaseCurrent = false;
+		if(broadphase != NULL)
+			broadphase->addObject(result);
 		return result;
 	}
 	
 	void World::destroyObject(CollisionObject* p_object)
 	{
-		int before = objects.size();
-		objects.remove(p_object);
-		if(before > objects.size())
-			delete p_object;
+		if(!objectPool.contains(p_object))
+			return;
+		
+		// gap is closed before the next iteration, so destroying many objects stays linear
+		objectVec[p_object->index] = NULL;
+		objectsRemoved = true;
+		queryTreeDirty = true;
+		queryTreeRebuild = true;
+		broadphaseCurrent = false;
+		if(p_object->inStaticTree)
+			staticTreeDirty = true;
+		if(broadphase != NULL)
+			broadphase->removeObject(p_object);
+		objectPool.destroy(p_object);
 	}
 	
 	void World::destroyAllObjects()
 	{
-		std::list<CollisionObject*>::iterator it;
-		for(it = objects.begin(); it != objects.end(); ++it)
-			delete (*it);
-		objects.clear();
+		objectPool.clear();
+		objectVec.clear();
+		boundsVec.clear();
+		objectsRemoved = false;
+		pairCache.clear();
+		staticTree.clear();
+		staticTreeDirty = false;
+		queryTree.clear();
+		queryTreeDirty = true;
+		queryTreeRebuild = true;
+		broadphaseCurrent = false;
+		if(broadphase != NULL)
+			broadphase->clear();
+	}
+	
+	CollisionObject* World::getObject(const ObjectHandle &p_handle) const
+	{
+		return objectPool.get(p_handle);
+	}
+	
+	void World::compactObjects()
+	{
+		if(!objectsRemoved)
+			return;
+		
+		// keep order of creation, all following objects move to the front
+		unsigned int count = 0;
+		for(int i = 0; i < objectVec.size(); ++i) {
+			if(objectVec[i] == NULL)
+				continue;
+			objectVec[count] = objectVec[i];
+			objectVec[count]->index = count;
+			++count;
+		}
+		objectVec.resize(count);
+		objectsRemoved = false;
 	}
 	
 	void World::step(const float p_sec, const int p_iterations)
 	{
-		float iterationSec = p_sec / ((float) p_iterations);
+		stepStats.clear();
+		shapeTestCount = 0;
+		
+		CDL_PROFILE_BEGIN(substepStart);
+		iterationCount = p_iterations;
+		if(adaptiveSubsteps && !continuous)
+			iterationCount = chooseSubsteps(p_sec, p_iterations);
+		iterationSec = p_sec / ((float) iterationCount);
+		queryTreeDirty = true;
+		CDL_PROFILE_END(substepStart, stepStats.integrationSec);
+		
+		for(iteration = 1; iteration <= iterationCount; ++iteration) {
+#ifdef CDL_PROFILING
+			float measuredSec = stepStats.integrationSec + stepStats.narrowphaseSec + stepStats.dispatchSec;
+#endif
+			CDL_PROFILE_BEGIN(collideStart);
+			if(pairCacheEnabled)
+				pairCache.nextIteration();
+			if(continuous) {
+				sweepObjects(iterationSec);
+			} else {
+				moveObjects(iterationSec);
+				collideObjects();
+			}
+			CDL_PROFILE_END(collideStart, stepStats.broadphaseSec);
+#ifdef CDL_PROFILING
+			// the other phases of the iteration were measured on their own
+			stepStats.broadphaseSec -= stepStats.integrationSec + stepStats.narrowphaseSec + stepStats.dispatchSec - measuredSec;
+#endif
+			
+			CDL_PROFILE_BEGIN(dispatchStart);
+			dispatchEvents();
+			CDL_PROFILE_END(dispatchStart, stepStats.dispatchSec);
+		}
+		stepStats.shapeTests = shapeTestCount;
+	}
+	
+	const StepStats& World::getStepStats() const
+	{
+		return stepStats;
+	}
+	
+	void World::updateQueryTree()
+	{
+		if(!queryTreeDirty)
+			return;
+		
+		// new objects and objects that were not due have no current world shapes yet
+		compactObjects();
+		for(int i = 0; i < objectVec.size(); ++i)
+			objectVec[i]->updateWorldShapes();
+		// moved objects only change the bounds of the nodes, the tree keeps its shape while it stays tight
+		if(queryTreeRebuild || !queryTree.refit())
+			queryTree.build(objectVec, threadPool);
+		queryTreeDirty = false;
+		queryTreeRebuild = false;
+	}
+	
+	bool World::raycast(const Line &p_ray, RaycastHit &p_hit)
+	{
+		updateQueryTree();
+		return queryTree.raycast(p_ray, p_hit);
+	}
+	
+	void World::raycast(const std::vector<Line> &p_rays, std::vector<RaycastHit> &p_hits)
+	{
+		updateQueryTree();
+		p_hits.resize(p_rays.size());
+		RaycastTask task(queryTree, p_rays, p_hits);
+		unsigned int chunkCount = (p_rays.size() + RAY_CHUNK_SIZE - 1) / RAY_CHUNK_SIZE;
+		if(threadPool != NULL) {
+			threadPool->run(chunkCount, task);
+			return;
+		}
+		for(unsigned int i = 0; i < chunkCount; ++i)
+			task.execute(0, i);
+	}
+	
+	void World::raycastAll(const Line &p_ray, std::vector<RaycastHit> &p_hits)
+	{
+		updateQueryTree();
+		p_hits.clear();
+		queryTree.raycastAll(p_ray, p_hits);
 		
-		for(int i = 0; i < p_iterations; ++i) {
-			moveObjects(iterationSec);
-			collideObjects();
+		// only the closest hit of each object is kept
+		std::sort(p_hits.begin(), p_hits.end(), compareObjectHits);
+		unsigned int count = 0;
+		for(int i = 0; i < p_hits.size(); ++i) {
+			if(count == 0 || p_hits[count - 1].object != p_hits[i].object)
+				p_hits[count++] = p_hits[i];
 		}
+		p_hits.resize(count);
+		std::sort(p_hits.begin(), p_hits.end(), compareHitFractions);
+	}
+	
+	bool World::shapeCast(const Circle &p_circle, const Vec2 &p_translation, RaycastHit &p_hit)
+	{
+		updateQueryTree();
+		return queryTree.castShape(ConvexShape(p_circle), boundsOf(p_circle), p_translation, p_hit);
+	}
+	
+	bool World::shapeCast(const Polygon &p_polygon, const Vec2 &p_translation, RaycastHit &p_hit)
+	{
+		updateQueryTree();
+		return queryTree.castShape(ConvexShape(p_polygon), boundsOf(p_polygon), p_translation, p_hit);
+	}
+	
+	void World::queryRegion(const AABB &p_bounds, QueryCallback &p_callback)
+	{
+		if(p_bounds.isEmpty())
+			return;
+		Polygon polygon = polygonOf(p_bounds);
+		queryRegion(p_bounds, NULL, &polygon, p_callback);
+	}
+	
+	void World::queryRegion(const Circle &p_circle, QueryCallback &p_callback)
+	{
+		queryRegion(boundsOf(p_circle), &p_circle, NULL, p_callback);
+	}
+	
+	void World::queryRegion(const Polygon &p_polygon, QueryCallback &p_callback)
+	{
+		queryRegion(boundsOf(p_polygon), NULL, &p_polygon, p_callback);
+	}
+	
+	void World::queryRegion(const AABB &p_bounds, const Circle *p_circle, const Polygon *p_polygon, QueryCallback &p_callback)
+	{
+		// the broadphase already knows where the objects are, unless objects were created or destroyed since
+		queryObjectVec.clear();
+		if(broadphase != NULL && broadphaseCurrent) {
+			broadphase->query(p_bounds, queryObjectVec);
+		} else {
+			updateQueryTree();
+			queryTree.query(p_bounds, queryObjectVec);
+		}
+		
+		// objects with several shapes are found once per shape
+		std::sort(queryObjectVec.begin(), queryObjectVec.end(), compareObjectIDs);
+		queryObjectVec.erase(std::unique(queryObjectVec.begin(), queryObjectVec.end()), queryObjectVec.end());
+		for(int i = 0; i < queryObjectVec.size(); ++i) {
+			CollisionObject *object = queryObjectVec[i];
+			bool overlaps = p_circle != NULL ? overlapObjectCircle(*object, *p_circle) : overlapObjectPolygon(*object, *p_polygon);
+			if(overlaps && !p_callback.reportObject(object))
+				return;
+		}
+	}
+	
+	unsigned int World::chooseSubsteps(const float p_sec, const int p_iterations)
+	{
+		unsigned int result = 1;
+		compactObjects();
+		for(int i = 0; i < objectVec.size(); ++i) {
+			CollisionObject *object = objectVec[i];
+			object->updateWorldShapes();
+			const AABB &bounds = object->bounds();
+			float size = std::min(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y);
+			float movement = object->linearVelocity.length() * p_sec;
+			
+			// points and lines have no size, they always take all substeps
+			object->substeps = p_iterations;
+			if(size > 0 && movement < maxSubstepMovement * size * p_iterations)
+				object->substeps = std::max(1, (int) ceil(movement / (maxSubstepMovement * size)));
+			result = std::max(result, object->substeps);
+		}
+		return result;
+	}
+	
+	bool World::isDue(const CollisionObject *p_object) const
+	{
+		if(!adaptiveSubsteps || continuous)
+			return true;
+		// substeps are spread evenly over the iterations, the last one is at the end of the step
+		unsigned int substeps = std::min(p_object->substeps, iterationCount);
+		return (iteration * substeps) / iterationCount != ((iteration - 1) * substeps) / iterationCount;
 	}
 	
 	void World::moveObjects(const float p_sec)
 	{
-		std::list<CollisionObject*>::iterator it;
-		for(it = objects.begin(); it != objects.end(); ++it)
-			(*it)->position += ((*it)->linearVelocity * p_sec);
+		CDL_PROFILE_BEGIN(moveStart);
+		compactObjects();
+		boundsVec.resize(objectVec.size());
+		for(int i = 0; i < objectVec.size(); ++i) {
+			CollisionObject *object = objectVec[i];
+			if(sleepIterations > 0)
+				updateSleeping(object);
+			checkStaticTree(object);
+			// swept objects only move up to their first contact
+			if(!object->isIdle())
+				object->position += (object->linearVelocity * (continuous ? moveSecVec[i] : p_sec));
+			// broadphases read the bounds of the objects, new objects have no bounds yet
+			if(broadphase != NULL || object->worldShapesDirty || isDue(object)) {
+				object->updateWorldShapes();
+				boundsVec[i] = object->bounds();
+			} else {
+				// shapes only move, so their bounds just have to be moved along
+				Vec2 movement = object->position - object->worldPosition;
+				boundsVec[i] = AABB(object->worldBounds.min + movement, object->worldBounds.max + movement);
+			}
+		}
+		CDL_PROFILE_END(moveStart, stepStats.integrationSec);
+	}
+	
+	void World::updateSleeping(CollisionObject *p_object)
+	{
+		if(p_object->staticBody)
+			return;
+		
+		// velocity, position or direction were changed since the last iteration
+		if(p_object->linearVelocity != Vec2(0, 0) || p_object->position != p_object->worldPosition || p_object->worldShapesDirty) {
+			p_object->wakeUp();
+			return;
+		}
+		if(!p_object->sleeping && ++p_object->idleIterations >= sleepIterations)
+			p_object->sleeping = true;
+	}
+	
+	void World::checkStaticTree(const CollisionObject *p_object)
+	{
+		// static objects that were added, changed or moved by the user need a new tree
+		if(staticTreeEnabled && (p_object->inStaticTree != p_object->staticBody || (p_object->inStaticTree && (p_object->position != p_object->worldPosition || p_object->worldShapesDirty))))
+			staticTreeDirty = true;
+	}
+	
+	bool World::isPairSkipped(const CollisionObject *p_objectA, const CollisionObject *p_objectB) const
+	{
+		return (!isDue(p_objectA) && !isDue(p_objectB)) || (p_objectA->isIdle() && p_objectB->isIdle());
+	}
+	
+	bool World::preparePair(CollisionObject *p_objectA, CollisionObject *p_objectB)
+	{
+		if(isPairSkipped(p_objectA, p_objectB))
+			return false;
+		
+		// bounds of a moving object touch the bounds of a sleeping one
+		if(p_objectA->sleeping)
+			p_objectA->wakeUp();
+		if(p_objectB->sleeping)
+			p_objectB->wakeUp();
+		return true;
 	}
 	
 	void World::collideObjects() 
 	{
-		std::list<CollisionObject*>::iterator it1, it2;
-		// check each object with each other
-		for(it1 = objects.begin(); it1 != objects.end(); ++it1) {
-			for(++(it2 = it1); it2 != objects.end(); ++it2)
-				collideObjects(*it1, *it2);
+		if(staticTreeEnabled) {
+			if(staticTreeDirty)
+				buildStaticTree();
+			findCandidatePairs(boundsVec);
+			if(threadPool != NULL)
+				collidePairsParallel();
+			else
+				collidePairs();
+			return;
+		}
+		
+		if(threadPool != NULL) {
+			findCandidatePairs(boundsVec);
+			collidePairsParallel();
+			return;
+		}
+		
+		if(broadphase != NULL) {
+			// only check candidate pairs, they are in the same order as below
+			pairVec.clear();
+			broadphase->findPairs(objectVec, boundsVec, pairVec);
+			broadphaseCurrent = true;
+			CDL_PROFILE_COUNT(stepStats.pairsConsidered, pairVec.size());
+			for(int i = 0; i < pairVec.size(); ++i) {
+				if(preparePair(pairVec[i].objectA, pairVec[i].objectB))
+					collideObjects(pairVec[i].objectA, pairVec[i].objectB);
+			}
+			return;
+		}
+		
+		// check each object with each other, bounds were packed when objects were moved
+		for(int i = 0; i < boundsVec.size(); ++i) {
+			const AABB &boundsA = boundsVec[i];
+			for(int j = i + 1; j < boundsVec.size(); ++j) {
+				if(!boundsA.overlaps(boundsVec[j]))
+					continue;
+				CDL_PROFILE_COUNT(stepStats.pairsConsidered, 1);
+				if(preparePair(objectVec[i], objectVec[j]))
+					collideObjects(objectVec[i], objectVec[j]);
+			}
 		}
 	}
 	
-	void World::collideObjects(CollisionObject *p_objectA, CollisionObject *p_objectB) {
-		bool collided = false;
-		std::vector<Vec2> intersectionPoints;
-		
-		std::vector<Circle> circlesA(p_objectA->circles());
-		std::vector<Circle> circlesB(p_objectB->circles());
-		std::vector<Polygon> polygonsA(p_objectA->polygons());
-		std::vector<Polygon> polygonsB(p_objectB->polygons());
-		
-		// positions of circles and polygons are only reltaive, calculate abs positions
-		for(int i = 0; i < circlesA.size(); ++i)
-			circlesA[i].mid += p_objectA->position;
-		for(int i = 0; i < circlesB.size(); ++i)
-			circlesB[i].mid += p_objectB->position;
-		for(int i = 0; i < polygonsA.size(); ++i) {
-			for(int j = 0; j < polygonsA[i].corners.size(); ++j)
-				polygonsA[i].corners[j] += p_objectA->position;
+	// objects that already touch are only held back while they move towards each other
+	static bool isApproaching(const CollisionObject &p_objectA, const CollisionObject &p_objectB)
+	{
+		const AABB &boundsA = p_objectA.bounds();
+		const AABB &boundsB = p_objectB.bounds();
+		Vec2 direction = (boundsB.min + boundsB.max) - (boundsA.min + boundsA.max);
+		return dot(p_objectB.linearVelocity - p_objectA.linearVelocity, direction) < 0;
+	}
+	
+	void World::sweepObjects(const float p_sec)
+	{
+		// objects are swept from where they are now, new ones have no world shapes yet
+		compactObjects();
+		sweptBoundsVec.resize(objectVec.size());
+		moveSecVec.assign(objectVec.size(), p_sec);
+		for(int i = 0; i < objectVec.size(); ++i) {
+			CollisionObject *object = objectVec[i];
+			checkStaticTree(object);
+			object->updateWorldShapes();
+			Vec2 movement = object->linearVelocity * p_sec;
+			AABB &bounds = sweptBoundsVec[i];
+			bounds = object->bounds();
+			bounds.merge(AABB(bounds.min + movement, bounds.max + movement));
+		}
+		if(staticTreeEnabled && staticTreeDirty)
+			buildStaticTree();
+		
+		// same candidates as in discrete mode, but with the bounds of the whole movement
+		findCandidatePairs(sweptBoundsVec);
+		sweepResultVec.resize(pairVec.size());
+		CDL_PROFILE_COUNT(stepStats.pairsTested, pairVec.size());
+		CDL_PROFILE_BEGIN(sweepStart);
+		SweepTask task(*this, p_sec);
+		if(threadPool != NULL)
+			threadPool->run((pairVec.size() + PAIR_CHUNK_SIZE - 1) / PAIR_CHUNK_SIZE, task);
+		else
+			for(unsigned int i = 0; i * PAIR_CHUNK_SIZE < pairVec.size(); ++i)
+				task.execute(0, i);
+		CDL_PROFILE_END(sweepStart, stepStats.narrowphaseSec);
+		
+		for(int i = 0; i < pairVec.size(); ++i) {
+			CollisionObject *objectA = pairVec[i].objectA;
+			CollisionObject *objectB = pairVec[i].objectB;
+			const SweepResult &result = sweepResultVec[i];
+			if(!result.hit) {
+				reportSeparation(objectA, objectB);
+			} else if(result.time > 0 || isApproaching(*objectA, *objectB)) {
+				moveSecVec[objectA->index] = std::min(moveSecVec[objectA->index], result.time);
+				moveSecVec[objectB->index] = std::min(moveSecVec[objectB->index], result.time);
+			}
 		}
-		for(int i = 0; i < polygonsB.size(); ++i) {
-			for(int j = 0; j < polygonsB[i].corners.size(); ++j)
-				polygonsB[i].corners[j] += p_objectB->position;
+		
+		moveObjects(p_sec);
+		for(int i = 0; i < pairVec.size(); ++i) {
+			if(!sweepResultVec[i].hit)
+				continue;
+			intersectionPointVec.assign(1, sweepResultVec[i].point);
+			reportCollision(pairVec[i].objectA, pairVec[i].objectB, intersectionPointVec, sweepResultVec[i].time);
+		}
+	}
+	
+	void World::buildStaticTree()
+	{
+		staticObjectVec.clear();
+		for(int i = 0; i < objectVec.size(); ++i) {
+			CollisionObject *object = objectVec[i];
+			object->inStaticTree = object->staticBody;
+			if(!object->inStaticTree)
+				continue;
+			object->updateWorldShapes();
+			staticObjectVec.push_back(object);
+		}
+		staticTree.build(staticObjectVec, threadPool);
+		staticTreeDirty = false;
+	}
+	
+	void World::addStaticTreePairs(const std::vector<AABB> &p_bounds)
+	{
+		// idle objects cannot collide with static ones
+		for(int i = 0; i < objectVec.size(); ++i) {
+			CollisionObject *object = objectVec[i];
+			if(object->inStaticTree || object->isIdle())
+				continue;
+			
+			// an object with several shapes in the tree is found once per shape
+			treeHitVec.clear();
+			staticTree.query(p_bounds[i], treeHitVec);
+			std::sort(treeHitVec.begin(), treeHitVec.end());
+			treeHitVec.erase(std::unique(treeHitVec.begin(), treeHitVec.end()), treeHitVec.end());
+			for(int j = 0; j < treeHitVec.size(); ++j) {
+				if(treeHitVec[j]->id < object->id)
+					pairVec.push_back(CollisionPair(treeHitVec[j], object));
+				else
+					pairVec.push_back(CollisionPair(object, treeHitVec[j]));
+			}
+		}
+		sortPairs(pairVec);
+	}
+	
+	void World::findCandidatePairs(const std::vector<AABB> &p_bounds)
+	{
+		pairVec.clear();
+		if(broadphase != NULL) {
+			broadphase->findPairs(objectVec, p_bounds, pairVec);
+			broadphaseCurrent = true;
+			// pairs with static objects are found in the tree
+			if(staticTreeEnabled) {
+				unsigned int count = 0;
+				for(int i = 0; i < pairVec.size(); ++i) {
+					if(!pairVec[i].objectA->inStaticTree && !pairVec[i].objectB->inStaticTree)
+						pairVec[count++] = pairVec[i];
+				}
+				pairVec.resize(count);
+			}
+		} else {
+			// same order as the brute force loop, objects are sorted by ID
+			for(int i = 0; i < p_bounds.size(); ++i) {
+				if(objectVec[i]->inStaticTree)
+					continue;
+				const AABB &boundsA = p_bounds[i];
+				for(int j = i + 1; j < p_bounds.size(); ++j) {
+					if(boundsA.overlaps(p_bounds[j]) && !objectVec[j]->inStaticTree)
+						pairVec.push_back(CollisionPair(objectVec[i], objectVec[j]));
+				}
+			}
 		}
+		if(staticTreeEnabled)
+			addStaticTreePairs(p_bounds);
+		CDL_PROFILE_COUNT(stepStats.pairsConsidered, pairVec.size());
+		
+		// workers must not change objects, so pairs are prepared and objects that are not due are updated here
+		unsigned int count = 0;
+		for(int i = 0; i < pairVec.size(); ++i) {
+			CollisionPair &pair = pairVec[i];
+			if(!preparePair(pair.objectA, pair.objectB))
+				continue;
+			pair.objectA->updateWorldShapes();
+			pair.objectB->updateWorldShapes();
+			// a cached axis only separates the current shapes, not a whole sweep
+			if(pairCacheEnabled && !continuous && isSeparated(pair.objectA, pair.objectB))
+				continue;
+			pairVec[count++] = pair;
+		}
+		pairVec.resize(count);
+	}
+	
+	void World::collidePairs()
+	{
+		// pairs were prepared while they were collected
+		for(int i = 0; i < pairVec.size(); ++i) {
+			intersectionPointVec.clear();
+			CDL_PROFILE_COUNT(stepStats.pairsTested, 1);
+			CDL_PROFILE_BEGIN(testStart);
+			bool collided = testObjects(pairVec[i].objectA, pairVec[i].objectB, intersectionPointVec);
+			CDL_PROFILE_END(testStart, stepStats.narrowphaseSec);
+			if(collided)
+				reportCollision(pairVec[i].objectA, pairVec[i].objectB, intersectionPointVec, iterationSec);
+			else
+				reportSeparation(pairVec[i].objectA, pairVec[i].objectB);
+		}
+	}
+	
+	void World::collidePairsParallel()
+	{
+		pairResultVec.resize(pairVec.size());
+		workerPointVec.resize(threadPool->getThreadCount());
+		for(int i = 0; i < workerPointVec.size(); ++i)
+			workerPointVec[i].clear();
+		
+		PairTask task(*this);
+		CDL_PROFILE_COUNT(stepStats.pairsTested, pairVec.size());
+		CDL_PROFILE_BEGIN(testStart);
+		threadPool->run((pairVec.size() + PAIR_CHUNK_SIZE - 1) / PAIR_CHUNK_SIZE, task);
+		CDL_PROFILE_END(testStart, stepStats.narrowphaseSec);
+		
+		// handler is only called by this thread and in order of the pairs
+		for(int i = 0; i < pairVec.size(); ++i) {
+			const PairResult &result = pairResultVec[i];
+			if(!result.collided) {
+				reportSeparation(pairVec[i].objectA, pairVec[i].objectB);
+				continue;
+			}
+			const std::vector<Vec2> &points = workerPointVec[result.worker];
+			intersectionPointVec.assign(points.begin() + result.pointStart, points.begin() + result.pointStart + result.pointCount);
+			reportCollision(pairVec[i].objectA, pairVec[i].objectB, intersectionPointVec, iterationSec);
+		}
+	}
+	
+	void World::collideObjects(CollisionObject *p_objectA, CollisionObject *p_objectB)
+	{
+		// objects that were not due in this iteration still have old shapes
+		p_objectA->updateWorldShapes();
+		p_objectB->updateWorldShapes();
+		if(pairCacheEnabled && isSeparated(p_objectA, p_objectB))
+			return;
+		
+		// reuse the memory of the last pair
+		intersectionPointVec.clear();
+		CDL_PROFILE_COUNT(stepStats.pairsTested, 1);
+		CDL_PROFILE_BEGIN(testStart);
+		bool collided = testObjects(p_objectA, p_objectB, intersectionPointVec);
+		CDL_PROFILE_END(testStart, stepStats.narrowphaseSec);
+		if(collided)
+			reportCollision(p_objectA, p_objectB, intersectionPointVec, iterationSec);
+		else
+			reportSeparation(p_objectA, p_objectB);
+	}
+	
+	void World::reportCollision(CollisionObject *p_objectA, CollisionObject *p_objectB, const std::vector<Vec2> &p_points, const float p_time)
+	{
+		CDL_PROFILE_COUNT(stepStats.intersectionPoints, p_points.size());
+		if(pairCacheEnabled) {
+			PairCache::Entry &entry = pairCache.visit(p_objectA, p_objectB);
+			contactBuffer.add(p_objectA, p_objectB, p_points, p_time);
+			contactTypeVec.push_back(entry.touching ? CONTACT_PERSIST : CONTACT_BEGIN);
+			entry.touching = true;
+			entry.hasAxis = false;
+		}
+		
+		if(deferEvents) {
+			eventBuffer.add(p_objectA, p_objectB, p_points, p_time);
+			return;
+		}
+		
+		CDL_PROFILE_BEGIN(dispatchStart);
+		CollisionEvent event(p_points, p_objectA, p_objectB, p_time);
+		collisionHandler->collide(event);
+		CDL_PROFILE_END(dispatchStart, stepStats.dispatchSec);
+	}
+	
+	// smallest and largest value of all shapes of an object on the axis
+	static void projectObject(const CollisionObject &p_object, const Vec2 &p_axis, float &p_min, float &p_max)
+	{
+		const std::vector<Circle> &circles = p_object.worldCircles();
+		const std::vector<Polygon> &polygons = p_object.worldPolygons();
+		float axisLength = p_axis.length();
+		
+		p_min = FLT_MAX;
+		p_max = -FLT_MAX;
+		for(int i = 0; i < circles.size(); ++i) {
+			float value = dot(circles[i].mid, p_axis);
+			p_min = std::min(p_min, value - circles[i].radius * axisLength);
+			p_max = std::max(p_max, value + circles[i].radius * axisLength);
+		}
+		for(int i = 0; i < polygons.size(); ++i) {
+			const std::vector<Vec2> &corners = polygons[i].corners;
+			for(int j = 0; j < corners.size(); ++j) {
+				float value = dot(corners[j], p_axis);
+				p_min = std::min(p_min, value);
+				p_max = std::max(p_max, value);
+			}
+		}
+	}
+	
+	static bool isSeparatedAlong(const CollisionObject &p_objectA, const CollisionObject &p_objectB, const Vec2 &p_axis)
+	{
+		float minA, maxA, minB, maxB;
+		projectObject(p_objectA, p_axis, minA, maxA);
+		projectObject(p_objectB, p_axis, minB, maxB);
+		// touching shapes collide
+		return maxA < minB || maxB < minA;
+	}
+	
+	bool World::isSeparated(CollisionObject *p_objectA, CollisionObject *p_objectB)
+	{
+		PairCache::Entry &entry = pairCache.visit(p_objectA, p_objectB);
+		return entry.hasAxis && isSeparatedAlong(*p_objectA, *p_objectB, entry.axis);
+	}
+	
+	void World::reportSeparation(CollisionObject *p_objectA, CollisionObject *p_objectB)
+	{
+		if(!pairCacheEnabled)
+			return;
+		
+		PairCache::Entry &entry = pairCache.visit(p_objectA, p_objectB);
+		if(entry.touching) {
+			contactBuffer.add(p_objectA, p_objectB, contactPointVec, iterationSec);
+			contactTypeVec.push_back(CONTACT_END);
+			entry.touching = false;
+		}
+		
+		// swept pairs are tested along their way, an axis of their end positions does not help
+		entry.hasAxis = false;
+		if(continuous)
+			return;
+		
+		// objects that are apart are usually separated along the line between their bounds
+		const AABB &boundsA = p_objectA->bounds();
+		const AABB &boundsB = p_objectB->bounds();
+		Vec2 axis = (boundsB.min + boundsB.max) - (boundsA.min + boundsA.max);
+		if(axis != Vec2(0, 0) && isSeparatedAlong(*p_objectA, *p_objectB, axis)) {
+			entry.axis = axis;
+			entry.hasAxis = true;
+		}
+	}
+	
+	void World::endStalePairs()
+	{
+		unvisitedPairVec.clear();
+		pairCache.findUnvisited(unvisitedPairVec);
+		contactPointVec.clear();
+		for(int i = 0; i < unvisitedPairVec.size(); ++i) {
+			const PairCache::Entry &entry = unvisitedPairVec[i];
+			CollisionObject *objectA = objectPool.get(entry.handleA);
+			CollisionObject *objectB = objectPool.get(entry.handleB);
+			// pair was not checked in this iteration, so it stays in the cache with its state
+			if(objectA != NULL && objectB != NULL && isPairSkipped(objectA, objectB))
+				continue;
+			pairCache.remove(entry);
+			// contacts of destroyed objects end without an event
+			if(objectA == NULL || objectB == NULL)
+				continue;
+			// bounds do not overlap anymore
+			if(entry.touching) {
+				contactBuffer.add(objectA, objectB, contactPointVec, iterationSec);
+				contactTypeVec.push_back(CONTACT_END);
+			}
+		}
+	}
+	
+	void World::dispatchContacts()
+	{
+		for(int i = 0; i < contactBuffer.size(); ++i) {
+			const Vec2 *points = contactBuffer.getIntersectionPoints(i);
+			contactPointVec.assign(points, points + contactBuffer.getIntersectionPointCount(i));
+			CollisionEvent event(contactPointVec, contactBuffer.getObjectA(i), contactBuffer.getObjectB(i), contactBuffer.getTime(i));
+			if(contactTypeVec[i] == CONTACT_BEGIN)
+				collisionHandler->beginContact(event);
+			else if(contactTypeVec[i] == CONTACT_PERSIST)
+				collisionHandler->persistContact(event);
+			else
+				collisionHandler->endContact(event);
+		}
+		contactBuffer.clear();
+		contactTypeVec.clear();
+		contactPointVec.clear();
+	}
+	
+	void World::dispatchEvents()
+	{
+		if(!eventBuffer.empty()) {
+			collisionHandler->collideBatch(eventBuffer);
+			eventBuffer.clear();
+		}
+		
+		if(pairCacheEnabled) {
+			endStalePairs();
+			dispatchContacts();
+		}
+	}
+	
+	bool World::testObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const
+	{
+		// objects that are far apart cannot collide
+		if(!p_objectA->bounds().overlaps(p_objectB->bounds()))
+			return false;
+		
+		if(narrowphase == NARROWPHASE_OVERLAP)
+			return overlapObjects(p_objectA, p_objectB);
+		else if(narrowphase == NARROWPHASE_SAT)
+			return separateObjects(p_objectA, p_objectB, p_points);
+		else if(narrowphase == NARROWPHASE_GJK)
+			return gjkCollideObjects(p_objectA, p_objectB, p_points);
+		else
+			return intersectObjects(p_objectA, p_objectB, p_points);
+	}
+	
+	/* The tests of the narrowphases for each kind of shape pair, 'testShapes()' walks the
+	 * pairs. The edge crossing tests handle all shapes, the other narrowphases fall back to
+	 * them for concave polygons. */
+	class World::IntersectionTest
+	{
+	protected:
+		std::vector<Vec2> &points;
+		ContactManifold manifold;
+		
+		bool addContactPoints(const bool p_collided)
+		{
+			if(p_collided) {
+				for(int i = 0; i < manifold.pointCount; ++i)
+					points.push_back(manifold.points[i]);
+			}
+			return p_collided;
+		}
+	public:
+		IntersectionTest(std::vector<Vec2> &p_points): points(p_points) { }
+		~IntersectionTest() { }
+		
+		bool testCircles(const Circle &p_circleA, const Circle &p_circleB)
+		{ return collideCircles(p_circleA, p_circleB, points); }
+		bool testCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, const bool)
+		{ return collideCirclePolygon(p_circle, p_polygon, points); }
+		bool testPolygonCircle(const Polygon &p_polygon, const bool, const Circle &p_circle)
+		{ return collideCirclePolygon(p_circle, p_polygon, points); }
+		bool testPolygons(const Polygon &p_polygonA, const bool, const Polygon &p_polygonB, const bool)
+		{ return collidePolygons(p_polygonA, p_polygonB, points); }
+	};
+	
+	class World::SeparatingAxisTest : public World::IntersectionTest
+	{
+	public:
+		SeparatingAxisTest(std::vector<Vec2> &p_points): IntersectionTest(p_points) { }
+		~SeparatingAxisTest() { }
+		
+		bool testCircles(const Circle &p_circleA, const Circle &p_circleB)
+		{ return addContactPoints(collideCircles(p_circleA, p_circleB, manifold)); }
+		
+		bool testCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, const bool p_convex)
+		{
+			if(!p_convex)
+				return IntersectionTest::testCirclePolygon(p_circle, p_polygon, p_convex);
+			return addContactPoints(collideCircleConvexPolygon(p_circle, p_polygon, manifold));
+		}
+		
+		bool testPolygonCircle(const Polygon &p_polygon, const bool p_convex, const Circle &p_circle)
+		{
+			if(!p_convex)
+				return IntersectionTest::testPolygonCircle(p_polygon, p_convex, p_circle);
+			return addContactPoints(collideCircleConvexPolygon(p_circle, p_polygon, manifold));
+		}
+		
+		bool testPolygons(const Polygon &p_polygonA, const bool p_convexA, const Polygon &p_polygonB, const bool p_convexB)
+		{
+			if(!p_convexA || !p_convexB)
+				return IntersectionTest::testPolygons(p_polygonA, p_convexA, p_polygonB, p_convexB);
+			return addContactPoints(collideConvexPolygons(p_polygonA, p_polygonB, manifold));
+		}
+	};
+	
+	// all convex shapes are handled the same
+	class World::GJKTest : public World::IntersectionTest
+	{
+	public:
+		GJKTest(std::vector<Vec2> &p_points): IntersectionTest(p_points) { }
+		~GJKTest() { }
+		
+		bool testCircles(const Circle &p_circleA, const Circle &p_circleB)
+		{ return addContactPoints(gjkCollide(ConvexShape(p_circleA), ConvexShape(p_circleB), manifold)); }
+		
+		bool testCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, const bool p_convex)
+		{
+			if(!p_convex)
+				return IntersectionTest::testCirclePolygon(p_circle, p_polygon, p_convex);
+			return addContactPoints(gjkCollide(ConvexShape(p_circle), ConvexShape(p_polygon), manifold));
+		}
+		
+		bool testPolygonCircle(const Polygon &p_polygon, const bool p_convex, const Circle &p_circle)
+		{
+			if(!p_convex)
+				return IntersectionTest::testPolygonCircle(p_polygon, p_convex, p_circle);
+			return addContactPoints(gjkCollide(ConvexShape(p_polygon), ConvexShape(p_circle), manifold));
+		}
+		
+		bool testPolygons(const Polygon &p_polygonA, const bool p_convexA, const Polygon &p_polygonB, const bool p_convexB)
+		{
+			if(!p_convexA || !p_convexB)
+				return IntersectionTest::testPolygons(p_polygonA, p_convexA, p_polygonB, p_convexB);
+			return addContactPoints(gjkCollide(ConvexShape(p_polygonA), ConvexShape(p_polygonB), manifold));
+		}
+	};
+	
+	// overlap tests handle concave polygons themselves
+	class World::OverlapTest
+	{
+	public:
+		OverlapTest() { }
+		~OverlapTest() { }
+		
+		bool testCircles(const Circle &p_circleA, const Circle &p_circleB)
+		{ return overlapCircles(p_circleA, p_circleB); }
+		bool testCirclePolygon(const Circle &p_circle, const Polygon &p_polygon, const bool)
+		{ return overlapCirclePolygon(p_circle, p_polygon); }
+		bool testPolygonCircle(const Polygon &p_polygon, const bool, const Circle &p_circle)
+		{ return overlapCirclePolygon(p_circle, p_polygon); }
+		bool testPolygons(const Polygon &p_polygonA, const bool, const Polygon &p_polygonB, const bool)
+		{ return overlapPolygons(p_polygonA, p_polygonB); }
+	};
+	
+	template<class ShapeTest>
+	bool World::testShapes(const CollisionObject &p_objectA, const CollisionObject &p_objectB, ShapeTest &p_test, const bool p_firstOnly) const
+	{
+		bool collided = false;
+		
+		// shapes in world space were updated when objects were moved
+		const std::vector<Circle> &circlesA = p_objectA.worldCircles();
+		const std::vector<Circle> &circlesB = p_objectB.worldCircles();
+		const std::vector<Polygon> &polygonsA = p_objectA.worldPolygons();
+		const std::vector<Polygon> &polygonsB = p_objectB.worldPolygons();
+		const std::vector<AABB> &circleBoundsA = p_objectA.worldCircleBounds();
+		const std::vector<AABB> &circleBoundsB = p_objectB.worldCircleBounds();
+		const std::vector<AABB> &polygonBoundsA = p_objectA.worldPolygonBounds();
+		const std::vector<AABB> &polygonBoundsB = p_objectB.worldPolygonBounds();
 		
 		// check for all circles of A
 		for(int i = 0; i < circlesA.size(); ++i) {
 			// check for all circles of B
 			for(int j = 0; j < circlesB.size(); ++j) {
-				if(collideCircles(circlesA[i], circlesB[j], intersectionPoints))
+				if(!circleBoundsA[i].overlaps(circleBoundsB[j]))
+					continue;
+				CDL_PROFILE_SHAPE_TEST();
+				if(p_test.testCircles(circlesA[i], circlesB[j])) {
+					if(p_firstOnly)
+						return true;
 					collided = true;
+				}
 			}
 			
 			// check for all polygons of B
 			for(int j = 0; j < polygonsB.size(); ++j) {
-				if(collideCirclePolygon(circlesA[i], polygonsB[j], intersectionPoints))
+				if(!circleBoundsA[i].overlaps(polygonBoundsB[j]))
+					continue;
+				CDL_PROFILE_SHAPE_TEST();
+				if(p_test.testCirclePolygon(circlesA[i], polygonsB[j], p_objectB.isPolygonConvex(j))) {
+					if(p_firstOnly)
+						return true;
 					collided = true;
+				}
 			}
 		}
 		
@@ -95,21 +1007,55 @@ namespace cdl
 		for(int i = 0; i < polygonsA.size(); ++i) {
 			// check for all circles of B
 			for(int j = 0; j < circlesB.size(); ++j) {
-				if(collideCirclePolygon(circlesB[j], polygonsA[i], intersectionPoints))
+				if(!polygonBoundsA[i].overlaps(circleBoundsB[j]))
+					continue;
+				CDL_PROFILE_SHAPE_TEST();
+				if(p_test.testPolygonCircle(polygonsA[i], p_objectA.isPolygonConvex(i), circlesB[j])) {
+					if(p_firstOnly)
+						return true;
 					collided = true;
+				}
 			}
 			
 			// check for all polygons of B
 			for(int j = 0; j < polygonsB.size(); ++j) {
-				if(collidePolygons(polygonsA[i], polygonsB[j], intersectionPoints))
+				if(!polygonBoundsA[i].overlaps(polygonBoundsB[j]))
+					continue;
+				CDL_PROFILE_SHAPE_TEST();
+				if(p_test.testPolygons(polygonsA[i], p_objectA.isPolygonConvex(i), polygonsB[j], p_objectB.isPolygonConvex(j))) {
+					if(p_firstOnly)
+						return true;
 					collided = true;
+				}
 			}
 		}
 		
-		if(collided) {
-			CollisionEvent event(intersectionPoints, p_objectA, p_objectB);
-			collisionHandler->collide(event);
-		}
+		return collided;
+	}
+	
+	bool World::intersectObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const
+	{
+		IntersectionTest test(p_points);
+		return testShapes(*p_objectA, *p_objectB, test, false);
+	}
+	
+	bool World::overlapObjects(CollisionObject *p_objectA, CollisionObject *p_objectB) const
+	{
+		// the first overlapping pair of shapes is enough
+		OverlapTest test;
+		return testShapes(*p_objectA, *p_objectB, test, true);
+	}
+	
+	bool World::separateObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const
+	{
+		SeparatingAxisTest test(p_points);
+		return testShapes(*p_objectA, *p_objectB, test, false);
+	}
+	
+	bool World::gjkCollideObjects(CollisionObject *p_objectA, CollisionObject *p_objectB, std::vector<Vec2> &p_points) const
+	{
+		GJKTest test(p_points);
+		return testShapes(*p_objectA, *p_objectB, test, false);
 	}
 	
 	void World::setCollisionHandler(CollisionHandler *p_collisionHandler)
@@ -121,4 +1067,78 @@ namespace cdl
 	{
 		collisionHandler = &defaultHandler;
 	}
+	
+	void World::setNarrowphase(const Narrowphase p_narrowphase)
+	{
+		narrowphase = p_narrowphase;
+	}
+	
+	void World::setThreadCount(const unsigned int p_threadCount)
+	{
+		delete threadPool;
+		threadPool = p_threadCount > 1 ? new ThreadPool(p_threadCount) : NULL;
+	}
+	
+	unsigned int World::getThreadCount() const
+	{
+		return threadPool != NULL ? threadPool->getThreadCount() : 1;
+	}
+	
+	void World::setDeferredEvents(const bool p_deferred)
+	{
+		deferEvents = p_deferred;
+	}
+	
+	void World::setContinuous(const bool p_continuous)
+	{
+		continuous = p_continuous;
+	}
+	
+	void World::setAdaptiveSubsteps(const bool p_adaptive, const float p_maxMovement)
+	{
+		adaptiveSubsteps = p_adaptive;
+		maxSubstepMovement = p_maxMovement;
+	}
+	
+	void World::setSleepIterations(const unsigned int p_iterations)
+	{
+		sleepIterations = p_iterations;
+		if(sleepIterations > 0)
+			return;
+		for(int i = 0; i < objectVec.size(); ++i) {
+			if(objectVec[i] != NULL)
+				objectVec[i]->wakeUp();
+		}
+	}
+	
+	void World::setPairCache(const bool p_enabled)
+	{
+		pairCacheEnabled = p_enabled;
+		pairCache.clear();
+	}
+	
+	void World::setStaticTree(const bool p_enabled)
+	{
+		staticTreeEnabled = p_enabled;
+		staticTreeDirty = p_enabled;
+		staticTree.clear();
+		for(int i = 0; i < objectVec.size(); ++i) {
+			if(objectVec[i] != NULL)
+				objectVec[i]->inStaticTree = false;
+		}
+	}
+	
+	void World::setBroadphase(Broadphase *p_broadphase)
+	{
+		if(broadphase != NULL)
+			broadphase->clear();
+		broadphase = p_broadphase;
+		broadphaseCurrent = false;
+		if(broadphase == NULL)
+			return;
+		
+		compactObjects();
+		for(int i = 0; i < objectVec.size(); ++i)
+			broadphase->addObject(objectVec[i]);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// counts every heap allocation of the test program while enabled
+static std::atomic<bool> countAllocations(false);
+static std::atomic<unsigned int> allocationCount(0);
+
+void* operator new(std::size_t p_size)
+{
+	if(countAllocations.load(std::memory_order_relaxed))
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void *result = std::malloc(p_size == 0 ? 1 : p_size);
+	if(result == NULL)
+		throw std::bad_alloc();
+	return result;
+}
+
+void operator delete(void *p_pointer) noexcept
+{
+	std::free(p_pointer);
+}
+
+SUITE(AllocationTests)
+{
+	class CountingCollisionHandler : public cdl::CollisionHandler
+	{
+	public:
+		unsigned int collisions;
+		unsigned int points;
+
+		CountingCollisionHandler(): collisions(0), points(0) { }
+
+		void collide(cdl::CollisionEvent &p_event)
+		{
+			++collisions;
+			points += p_event.getIntersectionPoints().size();
+		}
+	};
+
+	// rows of overlapping boxes and circles that move together, so the same pairs collide every step
+	static void createMovingScene(cdl::World &p_world)
+	{
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		cdl::Polygon box;
+		box.corners.push_back(cdl::Vec2(-1, -1));
+		box.corners.push_back(cdl::Vec2(1, -1));
+		box.corners.push_back(cdl::Vec2(1, 1));
+		box.corners.push_back(cdl::Vec2(-1, 1));
+
+		for(int i = 0; i < 10; ++i) {
+			for(int j = 0; j < 10; ++j) {
+				circles.clear();
+				polygons.clear();
+				if((i + j) % 2 == 0)
+					polygons.push_back(box);
+				else
+					circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+				cdl::CollisionObject *object = p_world.createObject(polygons, circles);
+				object->position.set(i * 1.5f, j * 5.0f);
+				object->linearVelocity.set(0.5f, 0.25f);
+			}
+		}
+	}
+
+	static unsigned int countStepAllocations(cdl::World &p_world, CountingCollisionHandler &p_handler)
+	{
+		createMovingScene(p_world);
+		p_world.setCollisionHandler(&p_handler);
+		// the first steps size all buffers
+		for(int i = 0; i < 3; ++i)
+			p_world.step(0.1f, 2);
+
+		p_handler.collisions = 0;
+		allocationCount = 0;
+		countAllocations = true;
+		for(int i = 0; i < 10; ++i)
+			p_world.step(0.1f, 2);
+		countAllocations = false;
+
+		return allocationCount;
+	}
+
+	TEST(StepDoesNotAllocate)
+	{
+		cdl::World world;
+		CountingCollisionHandler handler;
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+		CHECK(handler.points > 0);
+
+		world.destroyAllObjects();
+	}
+
+	TEST(StepDoesNotAllocateWithSweepAndPrune)
+	{
+		cdl::World world;
+		cdl::SweepAndPrune broadphase;
+		CountingCollisionHandler handler;
+		world.setBroadphase(&broadphase);
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+
+		world.destroyAllObjects();
+	}
+
+	TEST(StepDoesNotAllocateWithDynamicAABBTree)
+	{
+		cdl::World world;
+		cdl::DynamicAABBTree broadphase;
+		CountingCollisionHandler handler;
+		world.setBroadphase(&broadphase);
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+
+		world.destroyAllObjects();
+	}
+
+	TEST(StepDoesNotAllocateWithSpatialHashGrid)
+	{
+		cdl::World world;
+		cdl::SpatialHashGrid broadphase(4.0f);
+		CountingCollisionHandler handler;
+		world.setBroadphase(&broadphase);
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+
+		world.destroyAllObjects();
+	}
+
+	TEST(StepDoesNotAllocateInNarrowphases)
+	{
+		const cdl::World::Narrowphase narrowphases[] = {cdl::World::NARROWPHASE_INTERSECTION, cdl::World::NARROWPHASE_SAT, cdl::World::NARROWPHASE_GJK};
+		for(int i = 0; i < 3; ++i) {
+			cdl::World world;
+			CountingCollisionHandler handler;
+			world.setNarrowphase(narrowphases[i]);
+			world.setPairCache(true);
+
+			CHECK(countStepAllocations(world, handler) == 0);
+			CHECK(handler.collisions > 0);
+
+			world.destroyAllObjects();
+		}
+	}
+
+	// resting objects fall asleep on top of each other and next to static ones, their pairs are skipped
+	static void createRestingScene(cdl::World &p_world)
+	{
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		for(int i = 0; i < 20; ++i) {
+			cdl::CollisionObject *object = p_world.createObject(polygons, circles);
+			object->position.set(i * 1.5f, -10);
+			object->setStatic(i % 2 == 0);
+		}
+	}
+
+	TEST(StepDoesNotAllocateWithSleepingPairs)
+	{
+		cdl::World world;
+		CountingCollisionHandler handler;
+		world.setPairCache(true);
+		world.setSleepIterations(2);
+		createRestingScene(world);
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+
+		world.destroyAllObjects();
+	}
+
+	TEST(StepDoesNotAllocateWithThreads)
+	{
+		cdl::World world;
+		CountingCollisionHandler handler;
+		world.setThreadCount(4);
+		world.setDeferredEvents(true);
+
+		CHECK(countStepAllocations(world, handler) == 0);
+		CHECK(handler.collisions > 0);
+
+		world.destroyAllObjects();
+	}
+}
@@ -2,6 +2,7 @@
 #include <cdl/cdl.hpp>
 #include <cdl/Utils.hpp>
 #include <cmath>
+#include <type_traits>
 
 SUITE(BasicTests)
 {
@@ -43,4 +44,54 @@ SUITE(BasicTests)
 		
 		CHECK(cdl::equal((dir2 - dir1), (M_PI / 2), 4));
 	}
+	
+	TEST(Vec2Helpers)
+	{
+		// the math is constexpr and Vec2 can be copied like plain memory
+		static_assert(std::is_trivially_copyable<cdl::Vec2>::value, "Vec2 is not trivially copyable");
+		static_assert(cdl::dot(cdl::Vec2(1, 2), cdl::Vec2(3, 4)) == 11, "dot is not constexpr");
+		static_assert((cdl::Vec2(1, 2) + cdl::Vec2(3, 4) * 2).x == 7, "operators are not constexpr");
+		
+		cdl::Vec2 v1(3, 4);
+		cdl::Vec2 v2(-2, 1);
+		CHECK(cdl::dot(v1, v2) == -2);
+		CHECK(cdl::cross(v1, v2) == 11);
+		CHECK(cdl::cross(v2, v1) == -11);
+		CHECK(-v1 == cdl::Vec2(-3, -4));
+		CHECK(v1.perpendicular() == cdl::Vec2(-4, 3));
+		
+		cdl::Vec2 normal = cdl::normalize(v1);
+		CHECK_CLOSE(0.6f, normal.x, 1e-6f);
+		CHECK_CLOSE(0.8f, normal.y, 1e-6f);
+		CHECK(cdl::normalize(cdl::Vec2()) == cdl::Vec2());
+		
+		cdl::Vec2 rotated = cdl::rotate(v1, M_PI / 2);
+		CHECK_CLOSE(-4, rotated.x, 1e-5f);
+		CHECK_CLOSE(3, rotated.y, 1e-5f);
+		CHECK(cdl::rotate(v1, 0, 1) == cdl::Vec2(-4, 3));
+	}
+	
+	TEST(AABB)
+	{
+		cdl::AABB empty;
+		cdl::Polygon polygon;
+		polygon.corners.push_back(cdl::Vec2(-1, 2));
+		polygon.corners.push_back(cdl::Vec2(3, 0));
+		polygon.corners.push_back(cdl::Vec2(0, -1));
+		
+		cdl::AABB polygonBounds = cdl::boundsOf(polygon);
+		CHECK(polygonBounds.min == cdl::Vec2(-1, -1) && polygonBounds.max == cdl::Vec2(3, 2));
+		cdl::AABB circleBounds = cdl::boundsOf(cdl::Circle(cdl::Vec2(5, 0), 2));
+		CHECK(circleBounds.min == cdl::Vec2(3, -2) && circleBounds.max == cdl::Vec2(7, 2));
+		
+		// touching bounds overlap
+		CHECK(polygonBounds.overlaps(circleBounds));
+		circleBounds.min.x += 0.5f;
+		CHECK(!polygonBounds.overlaps(circleBounds));
+		
+		CHECK(empty.isEmpty());
+		CHECK(!empty.overlaps(polygonBounds));
+		empty.merge(circleBounds);
+		CHECK(empty.min == circleBounds.min && empty.max == circleBounds.max);
+	}
 }
\ No newline at end of file
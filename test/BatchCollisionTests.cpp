@@ -0,0 +1,82 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <cstdlib>
+#include <vector>
+
+SUITE(BatchCollision)
+{
+	static cdl::Vec2 randomPoint()
+	{
+		return cdl::Vec2(randomFloat(-5, 5), randomFloat(-5, 5));
+	}
+
+	TEST(CircleBatch)
+	{
+		cdl::CircleBatch batch;
+		std::vector<unsigned char> hitMask;
+		std::vector<cdl::Vec2> points, expectedPoints;
+		srand(17);
+
+		// size is no multiple of the SIMD width, the rest is tested scalar
+		for(int i = 0; i < 37; ++i)
+			batch.add(cdl::Circle(randomPoint(), randomFloat(0.1f, 2)));
+		// tangent circle is a hit
+		batch.add(cdl::Circle(cdl::Vec2(3, 0), 2));
+
+		cdl::Circle circle(cdl::Vec2(0, 0), 1);
+		unsigned int count = cdl::overlapCircleBatch(circle, batch, hitMask, &points);
+		CHECK(hitMask.size() == batch.size());
+		CHECK(hitMask.back() == 1);
+
+		unsigned int expectedCount = 0;
+		for(int i = 0; i < batch.size(); ++i) {
+			bool expected = cdl::overlapCircles(circle, batch.get(i));
+			CHECK(hitMask[i] == expected);
+			if(expected) {
+				++expectedCount;
+				cdl::collideCircles(circle, batch.get(i), expectedPoints);
+			}
+		}
+		CHECK(count == expectedCount);
+		CHECK(points == expectedPoints);
+	}
+
+	TEST(LineSegmentBatch)
+	{
+		cdl::LineSegmentBatch batch1, batch2;
+		std::vector<unsigned char> hitMask;
+		std::vector<cdl::Vec2> points, expectedPoints;
+		srand(19);
+
+		for(int i = 0; i < 13; ++i)
+			batch1.add(cdl::Line(randomPoint(), randomPoint()));
+		for(int i = 0; i < 21; ++i)
+			batch2.add(cdl::Line(randomPoint(), randomPoint()));
+		// parallel line segments never collide
+		batch1.add(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(1, 0)));
+		batch2.add(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(2, 0)));
+
+		unsigned int count = cdl::collideLineSegmentBatch(batch1, batch2, hitMask, &points);
+		CHECK(hitMask.size() == batch1.size() * batch2.size());
+		CHECK(hitMask.back() == 0);
+
+		unsigned int expectedCount = 0;
+		for(int i = 0; i < batch1.size(); ++i) {
+			for(int j = 0; j < batch2.size(); ++j) {
+				bool expected = cdl::collideLineSegments(batch1.get(i), batch2.get(j), expectedPoints);
+				CHECK(hitMask[i * batch2.size() + j] == expected);
+				if(expected)
+					++expectedCount;
+			}
+		}
+		CHECK(count > 0);
+		CHECK(count == expectedCount);
+		CHECK(points == expectedPoints);
+
+		// single line segment against the batch is the first row
+		std::vector<unsigned char> rowMask;
+		cdl::collideLineSegmentBatch(batch1.get(0), batch2, rowMask);
+		CHECK(std::vector<unsigned char>(hitMask.begin(), hitMask.begin() + batch2.size()) == rowMask);
+	}
+}
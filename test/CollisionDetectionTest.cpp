@@ -1,5 +1,6 @@
 #include <UnitTest++.h>
 #include <cdl/cdl.hpp>
+#include <cmath>
 #include <vector>
 
 SUITE(CollisionDetection)
@@ -267,4 +268,82 @@ SUITE(CollisionDetection)
 		CHECK(intersectionPoints[0] == cdl::Vec2(-2, 1));
 		CHECK(intersectionPoints[1] == cdl::Vec2(-1, 0));
 	}
+	
+	TEST(CornerDuplicates)
+	{
+		cdl::Polygon p1, p2;
+		std::vector<cdl::Vec2> intersectionPoints;
+		
+		p1.corners.push_back(cdl::Vec2(0, 0));
+		p1.corners.push_back(cdl::Vec2(2, 0));
+		p1.corners.push_back(cdl::Vec2(2, 2));
+		p1.corners.push_back(cdl::Vec2(0, 2));
+		
+		p2.corners.push_back(cdl::Vec2(2, 2));
+		p2.corners.push_back(cdl::Vec2(4, 2));
+		p2.corners.push_back(cdl::Vec2(4, 4));
+		p2.corners.push_back(cdl::Vec2(2, 4));
+		
+		//polygons touch corner on corner, all four edges of the corner find it
+		CHECK(cdl::collidePolygons(p1, p2, intersectionPoints));
+		CHECK(intersectionPoints.size() == 1);
+		CHECK(intersectionPoints[0] == cdl::Vec2(2, 2));
+		
+		//line through two corners, the first corner is found by the first and the last edge
+		intersectionPoints.clear();
+		CHECK(cdl::collideLinePolygon(cdl::Line(cdl::Vec2(-1, -1), cdl::Vec2(3, 3)), p1, intersectionPoints));
+		CHECK(intersectionPoints.size() == 2);
+		CHECK(intersectionPoints[0] == cdl::Vec2(0, 0));
+		CHECK(intersectionPoints[1] == cdl::Vec2(2, 2));
+		
+		//circle through all corners, every edge finds both of its corners
+		intersectionPoints.clear();
+		CHECK(cdl::collideCirclePolygon(cdl::Circle(cdl::Vec2(1, 1), std::sqrt(2.0f)), p1, intersectionPoints));
+		CHECK(intersectionPoints.size() == 4);
+		
+		//points already in the vector are kept
+		intersectionPoints.assign(1, cdl::Vec2(2, 2));
+		CHECK(cdl::collidePolygons(p1, p2, intersectionPoints));
+		CHECK(intersectionPoints.size() == 2);
+	}
+	
+	TEST(Overlap)
+	{
+		cdl::Polygon outer, inner;
+		std::vector<cdl::Vec2> intersectionPoints;
+		
+		outer.corners.push_back(cdl::Vec2(-3, 3));
+		outer.corners.push_back(cdl::Vec2(3, 3));
+		outer.corners.push_back(cdl::Vec2(3, -3));
+		outer.corners.push_back(cdl::Vec2(-3, -3));
+		
+		inner.corners.push_back(cdl::Vec2(-1, 1));
+		inner.corners.push_back(cdl::Vec2(1, 1));
+		inner.corners.push_back(cdl::Vec2(1, -1));
+		
+		// inner polygon does not cross any edge, but is inside
+		CHECK(!cdl::collidePolygons(outer, inner, intersectionPoints));
+		CHECK(cdl::overlapPolygons(outer, inner));
+		CHECK(cdl::overlapPolygons(inner, outer));
+		CHECK(cdl::overlapPointPolygon(cdl::Vec2(2, -2), outer));
+		CHECK(!cdl::overlapPointPolygon(cdl::Vec2(4, 0), outer));
+		
+		// circle inside of polygon and polygon inside of circle
+		CHECK(cdl::overlapCirclePolygon(cdl::Circle(cdl::Vec2(0, 0), 1), outer));
+		CHECK(cdl::overlapCirclePolygon(cdl::Circle(cdl::Vec2(0, 0), 10), inner));
+		CHECK(cdl::overlapCirclePolygon(cdl::Circle(cdl::Vec2(4, 0), 1), outer));
+		CHECK(!cdl::overlapCirclePolygon(cdl::Circle(cdl::Vec2(5, 0), 1), outer));
+		
+		CHECK(cdl::overlapCircles(cdl::Circle(cdl::Vec2(0, 0), 3), cdl::Circle(cdl::Vec2(1, 0), 1)));
+		CHECK(cdl::overlapCircles(cdl::Circle(cdl::Vec2(-1, 0), 1), cdl::Circle(cdl::Vec2(1, 0), 1)));
+		CHECK(!cdl::overlapCircles(cdl::Circle(cdl::Vec2(-1, 0), 1), cdl::Circle(cdl::Vec2(2, 0), 1)));
+		
+		// line segment inside of circle
+		CHECK(cdl::overlapLineSegmentCircle(cdl::Line(cdl::Vec2(-1, 0), cdl::Vec2(1, 0)), cdl::Circle(cdl::Vec2(0, 0), 2)));
+		CHECK(!cdl::overlapLineSegmentCircle(cdl::Line(cdl::Vec2(3, 0), cdl::Vec2(5, 0)), cdl::Circle(cdl::Vec2(0, 0), 2)));
+		CHECK(cdl::overlapLineCircle(cdl::Line(cdl::Vec2(3, 0), cdl::Vec2(5, 0)), cdl::Circle(cdl::Vec2(0, 0), 2)));
+		CHECK(cdl::overlapLineSegmentPolygon(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(0.5f, 0)), inner));
+		CHECK(cdl::overlapLinePolygon(cdl::Line(cdl::Vec2(10, 0), cdl::Vec2(11, 0)), outer));
+		CHECK(cdl::overlapLineSegments(cdl::Line(cdl::Vec2(1, 0), cdl::Vec2(4, 3)), cdl::Line(cdl::Vec2(1, 4), cdl::Vec2(4, 1))));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <cmath>
+#include <vector>
+
+SUITE(ContinuousCollision)
+{
+	TEST(SweepCircles)
+	{
+		float time;
+		cdl::Circle circle1(cdl::Vec2(0, 0), 1);
+
+		// both circles move towards each other
+		CHECK(cdl::sweepCircles(circle1, cdl::Vec2(1, 0), cdl::Circle(cdl::Vec2(10, 0), 1), cdl::Vec2(-3, 0), 5, time));
+		CHECK_CLOSE(2.0f, time, 1e-5f);
+
+		// too slow for the given time
+		CHECK(!cdl::sweepCircles(circle1, cdl::Vec2(1, 0), cdl::Circle(cdl::Vec2(10, 0), 1), cdl::Vec2(-3, 0), 1, time));
+		// passing by
+		CHECK(!cdl::sweepCircles(circle1, cdl::Vec2(0, 0), cdl::Circle(cdl::Vec2(10, 3), 1), cdl::Vec2(-10, 0), 2, time));
+		// moving apart
+		CHECK(!cdl::sweepCircles(circle1, cdl::Vec2(0, 0), cdl::Circle(cdl::Vec2(3, 0), 1), cdl::Vec2(1, 0), 2, time));
+
+		CHECK(cdl::sweepCircles(circle1, cdl::Vec2(0, 0), cdl::Circle(cdl::Vec2(1, 0), 1), cdl::Vec2(1, 0), 2, time));
+		CHECK(time == 0);
+	}
+
+	TEST(SweepConvexShapes)
+	{
+		float time;
+		cdl::Polygon box1 = createBox(cdl::Vec2(0, 0), 1, 1);
+		cdl::Polygon box2 = createBox(cdl::Vec2(10, 0.5f), 1, 1);
+
+		CHECK(cdl::sweepConvexShapes(box1, cdl::Vec2(0, 0), box2, cdl::Vec2(-4, 0), 5, time));
+		CHECK_CLOSE(2.0f, time, 1e-3f);
+		CHECK(!cdl::sweepConvexShapes(box1, cdl::Vec2(0, 0), box2, cdl::Vec2(-4, 0), 1, time));
+		CHECK(!cdl::sweepConvexShapes(box1, cdl::Vec2(0, 0), box2, cdl::Vec2(0, 4), 5, time));
+
+		// circle hits the corner of the box diagonally
+		CHECK(cdl::sweepConvexShapes(box1, cdl::Vec2(0, 0), cdl::Circle(cdl::Vec2(4, 4), 1), cdl::Vec2(-1, -1), 5, time));
+		CHECK_CLOSE(3 - 1 / sqrt(2.0f), time, 1e-3f);
+	}
+
+	TEST(SweepObjects)
+	{
+		float time;
+		cdl::Vec2 point;
+		std::vector<cdl::Polygon> polygons;
+		std::vector<cdl::Circle> circles;
+
+		// concave polygon, the bullet flies into its notch
+		cdl::Polygon notch;
+		notch.corners.push_back(cdl::Vec2(-2, 2));
+		notch.corners.push_back(cdl::Vec2(0, 0));
+		notch.corners.push_back(cdl::Vec2(2, 2));
+		notch.corners.push_back(cdl::Vec2(2, -2));
+		notch.corners.push_back(cdl::Vec2(-2, -2));
+		polygons.push_back(notch);
+		cdl::CollisionObject wall(polygons);
+		wall.updateWorldShapes();
+
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.1f));
+		cdl::CollisionObject bullet(circles);
+		bullet.position.set(0, 10);
+		bullet.linearVelocity.set(0, -100);
+		bullet.updateWorldShapes();
+
+		// both edges of the notch are touched at once, the first one is reported
+		CHECK(cdl::sweepObjects(wall, bullet, 1, time, point));
+		CHECK_CLOSE((10 - 0.1f * sqrt(2.0f)) / 100, time, 1e-4f);
+		CHECK_CLOSE(-0.05f * sqrt(2.0f), point.x, 1e-3f);
+		CHECK_CLOSE(0.05f * sqrt(2.0f), point.y, 1e-3f);
+	}
+
+	class TimeCollisionHandler : public cdl::CollisionHandler
+	{
+	public:
+		int collisions;
+		float time;
+		cdl::Vec2 point;
+
+		TimeCollisionHandler(): collisions(0), time(-1) { }
+
+		void collide(cdl::CollisionEvent &p_event)
+		{
+			++collisions;
+			time = p_event.getTime();
+			if(!p_event.getIntersectionPoints().empty())
+				point = p_event.getIntersectionPoints()[0];
+		}
+	};
+
+	TEST(WorldNoTunnelling)
+	{
+		cdl::World discreteWorld, continuousWorld;
+		TimeCollisionHandler discreteHandler, continuousHandler;
+		std::vector<cdl::Polygon> polygons;
+		std::vector<cdl::Circle> circles;
+		polygons.push_back(createBox(cdl::Vec2(0, 0), 0.1f, 5));
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.5f));
+
+		discreteWorld.createObject(polygons, std::vector<cdl::Circle>());
+		cdl::CollisionObject *discreteBullet = discreteWorld.createObject(std::vector<cdl::Polygon>(), circles);
+		continuousWorld.createObject(polygons, std::vector<cdl::Circle>());
+		cdl::CollisionObject *continuousBullet = continuousWorld.createObject(std::vector<cdl::Polygon>(), circles);
+		discreteWorld.setCollisionHandler(&discreteHandler);
+		continuousWorld.setCollisionHandler(&continuousHandler);
+		continuousWorld.setContinuous(true);
+
+		// bullet jumps over the wall in one iteration
+		discreteBullet->position.set(-10, 1);
+		discreteBullet->linearVelocity.set(20, 0);
+		continuousBullet->position.set(-10, 1);
+		continuousBullet->linearVelocity.set(20, 0);
+
+		discreteWorld.step(1, 1);
+		continuousWorld.step(1, 1);
+		CHECK(discreteHandler.collisions == 0);
+		CHECK(continuousHandler.collisions == 1);
+		CHECK_CLOSE(9.4f / 20, continuousHandler.time, 1e-4f);
+		CHECK_CLOSE(-0.1f, continuousHandler.point.x, 1e-3f);
+		CHECK_CLOSE(1.0f, continuousHandler.point.y, 1e-3f);
+
+		discreteWorld.destroyAllObjects();
+		continuousWorld.destroyAllObjects();
+	}
+
+	TEST(WorldStopsAtFirstContact)
+	{
+		cdl::World world;
+		TimeCollisionHandler handler;
+		std::vector<cdl::Circle> circles;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.5f));
+
+		cdl::CollisionObject *obstacle = world.createObject(std::vector<cdl::Polygon>(), circles);
+		cdl::CollisionObject *bullet = world.createObject(std::vector<cdl::Polygon>(), circles);
+		world.setCollisionHandler(&handler);
+		world.setContinuous(true);
+
+		// handler keeps the velocity, the bullet still must not pass the obstacle
+		bullet->position.set(-10, 0);
+		bullet->linearVelocity.set(100, 0);
+		world.step(1, 1);
+		CHECK(handler.collisions == 1);
+		CHECK_CLOSE(0.09f, handler.time, 1e-4f);
+		CHECK_CLOSE(-1.0f, bullet->position.x, 1e-3f);
+		CHECK(obstacle->position == cdl::Vec2(0, 0));
+
+		// touching objects stay together while they push against each other
+		world.step(1, 1);
+		CHECK(handler.collisions == 2);
+		CHECK_CLOSE(-1.0f, bullet->position.x, 1e-3f);
+
+		// and move apart freely
+		bullet->linearVelocity.set(-100, 0);
+		world.step(1, 1);
+		CHECK_CLOSE(-101.0f, bullet->position.x, 1e-3f);
+
+		world.destroyAllObjects();
+	}
+}
@@ -0,0 +1,87 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+SUITE(GJK)
+{
+	TEST(Distance)
+	{
+		cdl::Vec2 pointA, pointB;
+		cdl::Polygon box1 = createBox(cdl::Vec2(0, 0), 1, 1);
+
+		CHECK_CLOSE(2.0f, cdl::gjkDistance(box1, createBox(cdl::Vec2(4, 0.5f), 1, 1), pointA, pointB), 1e-5f);
+		CHECK_CLOSE(1.0f, pointA.x, 1e-5f);
+		CHECK_CLOSE(3.0f, pointB.x, 1e-5f);
+
+		// circle in front of a corner
+		CHECK_CLOSE(sqrt(2.0f) - 1, cdl::gjkDistance(box1, cdl::Circle(cdl::Vec2(2, 2), 1), pointA, pointB), 1e-5f);
+		CHECK(pointA == cdl::Vec2(1, 1));
+
+		CHECK_CLOSE(1.0f, cdl::gjkDistance(cdl::Line(cdl::Vec2(-1, 2), cdl::Vec2(1, 2)), box1, pointA, pointB), 1e-5f);
+		CHECK_CLOSE(0.0f, cdl::gjkDistance(box1, createBox(cdl::Vec2(1.5f, 0), 1, 1), pointA, pointB), 1e-5f);
+	}
+
+	TEST(Penetration)
+	{
+		cdl::ContactManifold manifold;
+		cdl::Polygon box1 = createBox(cdl::Vec2(0, 0), 1, 1);
+
+		CHECK(!cdl::gjkCollide(box1, createBox(cdl::Vec2(3, 0), 1, 1), manifold));
+		CHECK(!cdl::gjkIntersect(box1, createBox(cdl::Vec2(3, 0), 1, 1)));
+
+		CHECK(cdl::gjkCollide(box1, createBox(cdl::Vec2(1.5f, 0.2f), 1, 1), manifold));
+		CHECK_CLOSE(0.5f, manifold.penetration, 1e-4f);
+		CHECK_CLOSE(1.0f, manifold.normal.x, 1e-4f);
+		CHECK_CLOSE(0.0f, manifold.normal.y, 1e-4f);
+
+		CHECK(cdl::gjkCollide(cdl::Circle(cdl::Vec2(0, 0), 1), cdl::Circle(cdl::Vec2(0, 1.5f), 1), manifold));
+		CHECK_CLOSE(0.5f, manifold.penetration, 1e-5f);
+		CHECK_CLOSE(1.0f, manifold.normal.y, 1e-5f);
+	}
+
+	TEST(MatchesSeparatingAxis)
+	{
+		cdl::ContactManifold gjkManifold, satManifold;
+		srand(5);
+
+		// random convex quads, penetration has to agree with SAT
+		for(int i = 0; i < 500; ++i) {
+			cdl::Polygon polygon1, polygon2;
+			float offset = 2.5f * (rand() / (float) RAND_MAX);
+			for(int j = 0; j < 4; ++j) {
+				float angle1 = (j + (rand() / (float) RAND_MAX) * 0.8f) * M_PI / 2;
+				float angle2 = (j + (rand() / (float) RAND_MAX) * 0.8f) * M_PI / 2;
+				polygon1.corners.push_back(cdl::Vec2(cos(angle1), sin(angle1)));
+				polygon2.corners.push_back(cdl::Vec2(offset + cos(angle2), sin(angle2)));
+			}
+
+			bool collided = cdl::collideConvexPolygons(polygon1, polygon2, satManifold);
+			CHECK(cdl::gjkCollide(polygon1, polygon2, gjkManifold) == collided);
+			if(collided)
+				CHECK_CLOSE(satManifold.penetration, gjkManifold.penetration, 1e-3f);
+		}
+	}
+
+	TEST(ObjectDistance)
+	{
+		cdl::Vec2 pointA, pointB;
+		std::vector<cdl::Circle> circlesA;
+		std::vector<cdl::Polygon> polygonsA, polygonsB;
+		circlesA.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		polygonsA.push_back(createBox(cdl::Vec2(0, 3), 1, 1));
+		polygonsB.push_back(createBox(cdl::Vec2(0, 0), 1, 1));
+		cdl::CollisionObject objectA(polygonsA, circlesA);
+		cdl::CollisionObject objectB(polygonsB);
+		objectA.position.set(4, 0);
+		objectA.updateWorldShapes();
+		objectB.updateWorldShapes();
+
+		// closest shape of objectA is the circle
+		CHECK_CLOSE(2.0f, cdl::gjkDistance(objectA, objectB, pointA, pointB), 1e-5f);
+		CHECK_CLOSE(3.0f, pointA.x, 1e-5f);
+		CHECK_CLOSE(1.0f, pointB.x, 1e-5f);
+	}
+}
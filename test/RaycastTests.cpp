@@ -0,0 +1,349 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+SUITE(Raycast)
+{
+	TEST(RaycastCircle)
+	{
+		float fraction;
+		cdl::Vec2 normal;
+		cdl::Circle circle(cdl::Vec2(5, 0), 1);
+
+		CHECK(cdl::raycastCircle(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(10, 0)), circle, fraction, normal));
+		CHECK_CLOSE(0.4f, fraction, 1e-5f);
+		CHECK_CLOSE(-1.0f, normal.x, 1e-5f);
+		CHECK_CLOSE(0.0f, normal.y, 1e-5f);
+
+		// too short, pointing away and passing by
+		CHECK(!cdl::raycastCircle(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(3, 0)), circle, fraction, normal));
+		CHECK(!cdl::raycastCircle(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(-10, 0)), circle, fraction, normal));
+		CHECK(!cdl::raycastCircle(cdl::Line(cdl::Vec2(0, 2), cdl::Vec2(10, 2)), circle, fraction, normal));
+
+		// ray starts inside
+		CHECK(cdl::raycastCircle(cdl::Line(cdl::Vec2(5, 0), cdl::Vec2(5, 10)), circle, fraction, normal));
+		CHECK(fraction == 0);
+		CHECK_CLOSE(-1.0f, normal.y, 1e-5f);
+	}
+
+	TEST(RaycastPolygon)
+	{
+		float fraction;
+		cdl::Vec2 normal;
+		cdl::Polygon box = createBox(cdl::Vec2(0, 5), 1, 1);
+
+		CHECK(cdl::raycastPolygon(cdl::Line(cdl::Vec2(0.5f, 0), cdl::Vec2(0.5f, 10)), box, fraction, normal));
+		CHECK_CLOSE(0.4f, fraction, 1e-5f);
+		CHECK_CLOSE(0.0f, normal.x, 1e-5f);
+		CHECK_CLOSE(-1.0f, normal.y, 1e-5f);
+
+		// normal points towards the start, whatever the order of the corners
+		CHECK(cdl::raycastPolygon(cdl::Line(cdl::Vec2(10, 5), cdl::Vec2(0, 5)), box, fraction, normal));
+		CHECK_CLOSE(0.9f, fraction, 1e-5f);
+		CHECK_CLOSE(1.0f, normal.x, 1e-5f);
+
+		CHECK(!cdl::raycastPolygon(cdl::Line(cdl::Vec2(2, 0), cdl::Vec2(2, 10)), box, fraction, normal));
+		CHECK(cdl::raycastPolygon(cdl::Line(cdl::Vec2(0, 5), cdl::Vec2(0, 10)), box, fraction, normal));
+		CHECK(fraction == 0);
+	}
+
+	TEST(CastShape)
+	{
+		float fraction;
+		cdl::Vec2 point, normal;
+		cdl::Polygon box = createBox(cdl::Vec2(5, 0), 1, 1);
+
+		// circle of radius 1 touches the box when its mid is at x = 3
+		CHECK(cdl::castShape(cdl::Circle(cdl::Vec2(0, 0), 1), cdl::Vec2(10, 0), box, fraction, point, normal));
+		CHECK_CLOSE(0.3f, fraction, 1e-3f);
+		CHECK_CLOSE(4.0f, point.x, 1e-3f);
+		CHECK_CLOSE(-1.0f, normal.x, 1e-3f);
+
+		CHECK(!cdl::castShape(cdl::Circle(cdl::Vec2(0, 3), 1), cdl::Vec2(10, 0), box, fraction, point, normal));
+		CHECK(!cdl::castShape(cdl::Circle(cdl::Vec2(0, 0), 1), cdl::Vec2(2, 0), box, fraction, point, normal));
+	}
+
+	TEST(WorldRaycast)
+	{
+		cdl::World world;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *nearCircle = world.createObject(polygons, circles);
+		cdl::CollisionObject *farCircle = world.createObject(polygons, circles);
+		polygons.push_back(createBox(cdl::Vec2(0, 0), 1, 1));
+		cdl::CollisionObject *box = world.createObject(polygons, std::vector<cdl::Circle>());
+		nearCircle->position.set(5, 0);
+		farCircle->position.set(10, 0);
+		box->position.set(15, 0.5f);
+
+		// queries see objects created since the last step
+		cdl::RaycastHit hit;
+		CHECK(world.raycast(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(20, 0)), hit));
+		CHECK(hit.object == nearCircle);
+		CHECK_CLOSE(0.2f, hit.fraction, 1e-5f);
+		CHECK_CLOSE(4.0f, hit.point.x, 1e-5f);
+
+		std::vector<cdl::RaycastHit> hits;
+		world.raycastAll(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(20, 0)), hits);
+		CHECK(hits.size() == 3);
+		CHECK(hits[0].object == nearCircle && hits[1].object == farCircle && hits[2].object == box);
+		CHECK_CLOSE(0.7f, hits[2].fraction, 1e-5f);
+
+		CHECK(world.shapeCast(cdl::Circle(cdl::Vec2(0, 1.8f), 0.5f), cdl::Vec2(20, 0), hit));
+		CHECK(hit.object == box);
+		// circle touches the upper left corner of the box
+		CHECK_CLOSE(13.6f / 20, hit.fraction, 1e-3f);
+		CHECK_CLOSE(14.0f, hit.point.x, 1e-3f);
+		CHECK_CLOSE(1.5f, hit.point.y, 1e-3f);
+		CHECK_CLOSE(-0.8f, hit.normal.x, 1e-2f);
+		CHECK_CLOSE(0.6f, hit.normal.y, 1e-2f);
+
+		// objects moved by a step are found at their new position
+		nearCircle->linearVelocity.set(0, 10);
+		world.step(1, 1);
+		CHECK(world.raycast(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(20, 0)), hit));
+		CHECK(hit.object == farCircle);
+
+		world.destroyObject(farCircle);
+		CHECK(world.raycast(cdl::Line(cdl::Vec2(0, 0), cdl::Vec2(20, 0)), hit));
+		CHECK(hit.object == box);
+		world.destroyAllObjects();
+	}
+
+	TEST(BatchedRaycastsMatchObjects)
+	{
+		cdl::World world;
+		std::vector<cdl::CollisionObject*> objects;
+		std::vector<cdl::Line> rays;
+		std::vector<cdl::RaycastHit> hits;
+
+		srand(3);
+		for(int i = 0; i < 300; ++i) {
+			std::vector<cdl::Circle> circles;
+			std::vector<cdl::Polygon> polygons;
+			if(i % 2 == 0)
+				circles.push_back(cdl::Circle(cdl::Vec2(0, 0), randomFloat(0.2f, 1)));
+			else
+				polygons.push_back(createBox(cdl::Vec2(0, 0), randomFloat(0.2f, 1), randomFloat(0.2f, 1)));
+			objects.push_back(world.createObject(polygons, circles));
+			objects.back()->position.set(randomFloat(-20, 20), randomFloat(-20, 20));
+			objects.back()->setDirection(randomFloat(0, 3));
+		}
+		for(int i = 0; i < 500; ++i)
+			rays.push_back(cdl::Line(cdl::Vec2(randomFloat(-25, 25), randomFloat(-25, 25)), cdl::Vec2(randomFloat(-25, 25), randomFloat(-25, 25))));
+
+		world.setThreadCount(3);
+		world.raycast(rays, hits);
+		CHECK(hits.size() == rays.size());
+
+		// closest hit of all objects, ties go to the lower ID
+		int hitCount = 0;
+		for(int i = 0; i < rays.size(); ++i) {
+			cdl::RaycastHit expected;
+			for(int j = 0; j < objects.size(); ++j) {
+				cdl::RaycastHit hit;
+				if(cdl::raycastObject(rays[i], *objects[j], hit) && (expected.object == NULL || hit.fraction < expected.fraction))
+					expected = hit;
+			}
+			CHECK(hits[i].object == expected.object);
+			if(expected.object != NULL) {
+				CHECK_CLOSE(expected.fraction, hits[i].fraction, 1e-5f);
+				++hitCount;
+			}
+		}
+		CHECK(hitCount > 100);
+		world.destroyAllObjects();
+	}
+
+	TEST(RefitTree)
+	{
+		cdl::ObjectPool pool;
+		std::vector<cdl::CollisionObject*> objects;
+		std::vector<cdl::Circle> circles;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.5f));
+		for(int i = 0; i < 100; ++i) {
+			objects.push_back(pool.create(std::vector<cdl::Polygon>(), circles));
+			objects.back()->position.set((i % 10) * 2.0f, (i / 10) * 2.0f);
+			objects.back()->updateWorldShapes();
+		}
+		cdl::StaticBVH tree;
+		tree.build(objects);
+		unsigned int nodeCount = tree.getNodeCount();
+
+		// small movements keep the tree, queries see the new bounds
+		for(int i = 0; i < objects.size(); ++i) {
+			objects[i]->position += cdl::Vec2(0.3f, -0.2f);
+			objects[i]->updateWorldShapes();
+		}
+		CHECK(tree.refit());
+		CHECK(tree.getNodeCount() == nodeCount);
+		cdl::AABB bounds(cdl::Vec2(3.9f, 3.9f), cdl::Vec2(4.1f, 4.1f));
+		std::vector<cdl::CollisionObject*> found;
+		tree.query(bounds, found);
+		CHECK(found.size() == 1 && found[0] == objects[22]);
+
+		// objects that are scattered make the nodes too large
+		for(int i = 0; i < objects.size(); ++i) {
+			objects[i]->position.set(randomFloat(-100, 100), randomFloat(-100, 100));
+			objects[i]->updateWorldShapes();
+		}
+		CHECK(!tree.refit());
+		pool.clear();
+	}
+
+	class RecordingQueryCallback : public cdl::QueryCallback
+	{
+	public:
+		std::vector<cdl::CollisionObject*> objects;
+		unsigned int limit;
+
+		RecordingQueryCallback(): limit(0) { }
+
+		bool reportObject(cdl::CollisionObject *p_object)
+		{
+			objects.push_back(p_object);
+			return limit == 0 || objects.size() < limit;
+		}
+	};
+
+	TEST(QueryRegionMatchesObjects)
+	{
+		cdl::World world;
+		std::vector<cdl::CollisionObject*> objects;
+		cdl::Circle circle(cdl::Vec2(2, -3), 6);
+		cdl::AABB bounds(cdl::Vec2(-10, -4), cdl::Vec2(-2, 8));
+		// concave region shaped like an L
+		cdl::Polygon polygon;
+		polygon.corners.push_back(cdl::Vec2(0, 0));
+		polygon.corners.push_back(cdl::Vec2(12, 0));
+		polygon.corners.push_back(cdl::Vec2(12, 3));
+		polygon.corners.push_back(cdl::Vec2(3, 3));
+		polygon.corners.push_back(cdl::Vec2(3, 12));
+		polygon.corners.push_back(cdl::Vec2(0, 12));
+
+		srand(17);
+		for(int i = 0; i < 300; ++i) {
+			std::vector<cdl::Circle> circles;
+			std::vector<cdl::Polygon> polygons;
+			if(i % 2 == 0)
+				circles.push_back(cdl::Circle(cdl::Vec2(0, 0), randomFloat(0.2f, 1)));
+			else
+				polygons.push_back(createBox(cdl::Vec2(0, 0), randomFloat(0.2f, 1), randomFloat(0.2f, 1)));
+			objects.push_back(world.createObject(polygons, circles));
+			objects.back()->position.set(randomFloat(-20, 20), randomFloat(-20, 20));
+			objects.back()->linearVelocity.set(randomFloat(-1, 1), randomFloat(-1, 1));
+		}
+		world.step(1, 2);
+
+		RecordingQueryCallback circleCallback, boundsCallback, polygonCallback;
+		world.queryRegion(circle, circleCallback);
+		world.queryRegion(bounds, boundsCallback);
+		world.queryRegion(polygon, polygonCallback);
+
+		// objects are reported in order of their IDs, like the objects were created
+		std::vector<cdl::CollisionObject*> expectedCircle, expectedBounds, expectedPolygon;
+		cdl::Polygon boundsPolygon = cdl::polygonOf(bounds);
+		for(int i = 0; i < objects.size(); ++i) {
+			if(cdl::overlapObjectCircle(*objects[i], circle))
+				expectedCircle.push_back(objects[i]);
+			if(cdl::overlapObjectPolygon(*objects[i], boundsPolygon))
+				expectedBounds.push_back(objects[i]);
+			if(cdl::overlapObjectPolygon(*objects[i], polygon))
+				expectedPolygon.push_back(objects[i]);
+		}
+		CHECK(!expectedCircle.empty() && !expectedBounds.empty() && !expectedPolygon.empty());
+		CHECK(circleCallback.objects == expectedCircle);
+		CHECK(boundsCallback.objects == expectedBounds);
+		CHECK(polygonCallback.objects == expectedPolygon);
+
+		// callback stops the query
+		RecordingQueryCallback limitedCallback;
+		limitedCallback.limit = 2;
+		world.queryRegion(circle, limitedCallback);
+		CHECK(limitedCallback.objects.size() == 2);
+		CHECK(limitedCallback.objects[1] == expectedCircle[1]);
+		world.destroyAllObjects();
+	}
+
+	TEST(QueryRegionWithBroadphases)
+	{
+		cdl::World worlds[4];
+		cdl::SweepAndPrune sweepAndPrune;
+		cdl::DynamicAABBTree tree;
+		cdl::SpatialHashGrid grid(2);
+		worlds[1].setBroadphase(&sweepAndPrune);
+		worlds[2].setBroadphase(&tree);
+		worlds[3].setBroadphase(&grid);
+		for(int i = 0; i < 4; ++i) {
+			srand(29);
+			for(int j = 0; j < 200; ++j) {
+				std::vector<cdl::Circle> circles;
+				std::vector<cdl::Polygon> polygons;
+				if(j % 2 == 0)
+					circles.push_back(cdl::Circle(cdl::Vec2(0, 0), randomFloat(0.2f, 1)));
+				else
+					polygons.push_back(createBox(cdl::Vec2(0, 0), randomFloat(0.2f, 3), randomFloat(0.2f, 1)));
+				cdl::CollisionObject *object = worlds[i].createObject(polygons, circles);
+				object->position.set(randomFloat(-20, 20), randomFloat(-20, 20));
+				object->linearVelocity.set(randomFloat(-1, 1), randomFloat(-1, 1));
+			}
+			worlds[i].step(1, 2);
+		}
+
+		// small and large regions, the grid checks all objects for the large one
+		cdl::Circle circle(cdl::Vec2(-3, 4), 5);
+		cdl::AABB bounds(cdl::Vec2(-30, -30), cdl::Vec2(30, 2));
+		RecordingQueryCallback circleCallbacks[4], boundsCallbacks[4];
+		for(int i = 0; i < 4; ++i) {
+			worlds[i].queryRegion(circle, circleCallbacks[i]);
+			worlds[i].queryRegion(bounds, boundsCallbacks[i]);
+		}
+		CHECK(!circleCallbacks[0].objects.empty() && !boundsCallbacks[0].objects.empty());
+		for(int i = 1; i < 4; ++i) {
+			CHECK(circleCallbacks[i].objects.size() == circleCallbacks[0].objects.size());
+			CHECK(boundsCallbacks[i].objects.size() == boundsCallbacks[0].objects.size());
+			for(int j = 0; j < circleCallbacks[0].objects.size() && j < circleCallbacks[i].objects.size(); ++j)
+				CHECK(circleCallbacks[i].objects[j]->getID() == circleCallbacks[0].objects[j]->getID());
+			for(int j = 0; j < boundsCallbacks[0].objects.size() && j < boundsCallbacks[i].objects.size(); ++j)
+				CHECK(boundsCallbacks[i].objects[j]->getID() == boundsCallbacks[0].objects[j]->getID());
+		}
+
+		// objects created since the last step are found without the broadphase
+		for(int i = 0; i < 4; ++i) {
+			std::vector<cdl::Circle> circles;
+			circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+			cdl::CollisionObject *object = worlds[i].createObject(std::vector<cdl::Polygon>(), circles);
+			object->position.set(50, 50);
+			RecordingQueryCallback callback;
+			worlds[i].queryRegion(cdl::Circle(cdl::Vec2(50, 50), 0.5f), callback);
+			CHECK(callback.objects.size() == 1 && callback.objects[0] == object);
+		}
+
+		for(int i = 1; i < 4; ++i)
+			worlds[i].setBroadphase(NULL);
+		for(int i = 0; i < 4; ++i)
+			worlds[i].destroyAllObjects();
+	}
+
+	TEST(QueryRegionContainment)
+	{
+		cdl::World world;
+		RecordingQueryCallback callback;
+		std::vector<cdl::Polygon> polygons;
+		polygons.push_back(createBox(cdl::Vec2(0, 0), 5, 5));
+		cdl::CollisionObject *big = world.createObject(polygons, std::vector<cdl::Circle>());
+
+		// region inside of the object
+		world.queryRegion(cdl::Circle(cdl::Vec2(1, 1), 0.5f), callback);
+		CHECK(callback.objects.size() == 1 && callback.objects[0] == big);
+		callback.objects.clear();
+		world.queryRegion(cdl::Circle(cdl::Vec2(7, 0), 1), callback);
+		CHECK(callback.objects.empty());
+		world.destroyAllObjects();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <UnitTest++.h>
+#include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+SUITE(SeparatingAxis)
+{
+	TEST(Convexity)
+	{
+		cdl::Polygon arrow;
+		arrow.corners.push_back(cdl::Vec2(0, 2));
+		arrow.corners.push_back(cdl::Vec2(2, -2));
+		arrow.corners.push_back(cdl::Vec2(0, 0));
+		arrow.corners.push_back(cdl::Vec2(-2, -2));
+
+		CHECK(cdl::isConvex(createBox(cdl::Vec2(0, 0), 1, 1)));
+		CHECK(!cdl::isConvex(arrow));
+		CHECK(!cdl::isConvex(cdl::Polygon()));
+	}
+
+	TEST(ConvexPolygonManifold)
+	{
+		cdl::ContactManifold manifold;
+		cdl::Polygon box1 = createBox(cdl::Vec2(0, 0), 1, 1);
+
+		CHECK(!cdl::collideConvexPolygons(box1, createBox(cdl::Vec2(3, 0), 1, 1), manifold));
+
+		// box2 overlaps box1 by 0.5 in x direction
+		CHECK(cdl::collideConvexPolygons(box1, createBox(cdl::Vec2(1.5f, 0.5f), 1, 1), manifold));
+		CHECK(manifold.normal == cdl::Vec2(1, 0));
+		CHECK_CLOSE(0.5f, manifold.penetration, 1e-5f);
+		CHECK(manifold.pointCount == 2);
+		for(int i = 0; i < manifold.pointCount; ++i) {
+			CHECK_CLOSE(0.5f, manifold.points[i].x, 1e-5f);
+			CHECK(manifold.points[i].y >= -0.5f && manifold.points[i].y <= 1);
+		}
+
+		// winding of the polygons does not matter, normal points from first to second
+		cdl::Polygon reversed = createBox(cdl::Vec2(0, -1.8f), 1, 1);
+		std::reverse(reversed.corners.begin(), reversed.corners.end());
+		CHECK(cdl::collideConvexPolygons(box1, reversed, manifold));
+		CHECK(manifold.normal == cdl::Vec2(0, -1));
+		CHECK_CLOSE(0.2f, manifold.penetration, 1e-5f);
+
+		// polygon inside of polygon
+		CHECK(cdl::collideConvexPolygons(createBox(cdl::Vec2(0, 0), 0.25f, 0.25f), box1, manifold));
+		CHECK(manifold.pointCount > 0);
+	}
+
+	TEST(CircleManifold)
+	{
+		cdl::ContactManifold manifold;
+		cdl::Polygon box = createBox(cdl::Vec2(0, 0), 1, 1);
+
+		CHECK(!cdl::collideCircleConvexPolygon(cdl::Circle(cdl::Vec2(3, 0), 1), box, manifold));
+		// corner region
+		CHECK(!cdl::collideCircleConvexPolygon(cdl::Circle(cdl::Vec2(1.8f, 1.8f), 1), box, manifold));
+
+		CHECK(cdl::collideCircleConvexPolygon(cdl::Circle(cdl::Vec2(0, 1.5f), 1), box, manifold));
+		CHECK(manifold.normal == cdl::Vec2(0, -1));
+		CHECK_CLOSE(0.5f, manifold.penetration, 1e-5f);
+		CHECK(manifold.points[0] == cdl::Vec2(0, 1));
+
+		CHECK(cdl::collideCircles(cdl::Circle(cdl::Vec2(0, 0), 1), cdl::Circle(cdl::Vec2(1.5f, 0), 1), manifold));
+		CHECK(manifold.normal == cdl::Vec2(1, 0));
+		CHECK_CLOSE(0.5f, manifold.penetration, 1e-5f);
+	}
+
+	TEST(MatchesOverlap)
+	{
+		cdl::ContactManifold manifold;
+		srand(3);
+
+		// random convex quads, SAT has to agree with the overlap test
+		for(int i = 0; i < 500; ++i) {
+			cdl::Polygon polygon1, polygon2;
+			float offset = 2.5f * (rand() / (float) RAND_MAX);
+			for(int j = 0; j < 4; ++j) {
+				float angle1 = (j + (rand() / (float) RAND_MAX) * 0.8f) * M_PI / 2;
+				float angle2 = (j + (rand() / (float) RAND_MAX) * 0.8f) * M_PI / 2;
+				polygon1.corners.push_back(cdl::Vec2(cos(angle1), sin(angle1)));
+				polygon2.corners.push_back(cdl::Vec2(offset + cos(angle2), sin(angle2)));
+			}
+
+			CHECK(cdl::collideConvexPolygons(polygon1, polygon2, manifold) == cdl::overlapPolygons(polygon1, polygon2));
+		}
+	}
+}
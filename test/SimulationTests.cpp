@@ -1,5 +1,11 @@
 #include <UnitTest++.h>
 #include <cdl/cdl.hpp>
+#include "TestShapes.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
 
 SUITE(SimulationTests)
 {
@@ -22,6 +28,76 @@ SUITE(SimulationTests)
 		world.destroyAllObjects();
 	}
 	
+	TEST(WorldShapeCache)
+	{
+		cdl::World world;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		cdl::Polygon polygon;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(1, 0), 1));
+		polygon.corners.push_back(cdl::Vec2(0, 1));
+		polygon.corners.push_back(cdl::Vec2(1, -1));
+		polygon.corners.push_back(cdl::Vec2(-1, -1));
+		polygons.push_back(polygon);
+		cdl::CollisionObject *obj = world.createObject(polygons, circles);
+		
+		obj->position.set(2, 3);
+		obj->updateWorldShapes();
+		CHECK(obj->worldCircles()[0].mid == cdl::Vec2(3, 3));
+		CHECK(obj->worldPolygons()[0].corners[1] == cdl::Vec2(3, 2));
+		
+		// world shapes follow the object when it moves
+		obj->linearVelocity.set(1, 0);
+		world.step(1, 1);
+		CHECK(obj->worldCircles()[0].mid == cdl::Vec2(4, 3));
+		CHECK(obj->worldPolygons()[0].corners[1] == cdl::Vec2(4, 2));
+		// local shapes stay untouched
+		CHECK(obj->circles()[0].mid == cdl::Vec2(1, 0));
+		// bounds of circle and polygon are merged
+		CHECK(obj->bounds().min == cdl::Vec2(2, 2) && obj->bounds().max == cdl::Vec2(5, 4));
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(Rotation)
+	{
+		cdl::World world;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		cdl::Polygon polygon;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(2, 0), 1));
+		polygon.corners.push_back(cdl::Vec2(1, 0));
+		polygon.corners.push_back(cdl::Vec2(0, 1));
+		polygon.corners.push_back(cdl::Vec2(-1, -1));
+		polygons.push_back(polygon);
+		cdl::CollisionObject *obj = world.createObject(polygons, circles);
+		obj->position.set(5, 5);
+		
+		// shapes turn counter-clockwise around the position
+		obj->setDirection(0.5f * M_PI);
+		obj->updateWorldShapes();
+		CHECK_CLOSE(5.0f, obj->worldCircles()[0].mid.x, 1e-5f);
+		CHECK_CLOSE(7.0f, obj->worldCircles()[0].mid.y, 1e-5f);
+		CHECK_CLOSE(5.0f, obj->worldPolygons()[0].corners[0].x, 1e-5f);
+		CHECK_CLOSE(6.0f, obj->worldPolygons()[0].corners[0].y, 1e-5f);
+		CHECK_CLOSE(6.0f, obj->worldPolygons()[0].corners[2].x, 1e-5f);
+		CHECK_CLOSE(4.0f, obj->worldPolygons()[0].corners[2].y, 1e-5f);
+		
+		// setting the direction again does not rotate further
+		for(int i = 0; i < 100; ++i)
+			obj->setDirection(0.5f * M_PI);
+		obj->setDirection(0);
+		obj->updateWorldShapes();
+		CHECK(obj->circles()[0].mid == cdl::Vec2(2, 0));
+		CHECK(obj->polygons()[0].corners[1] == cdl::Vec2(0, 1));
+		CHECK(obj->worldPolygons()[0].corners[1] == cdl::Vec2(5, 6));
+		CHECK(obj->getDirection() == 0);
+		
+		world.destroyAllObjects();
+	}
+	
 	class TestCollisionHandler : public cdl::CollisionHandler
 	{
 	public:
@@ -76,4 +152,729 @@ SUITE(SimulationTests)
 		
 		world.destroyAllObjects();
 	}
+	
+	class RecordingCollisionHandler : public cdl::CollisionHandler
+	{
+	public:
+		std::vector<std::pair<unsigned int, unsigned int> > events;
+		std::vector<cdl::Vec2> points;
+		
+		void collide(cdl::CollisionEvent &p_event)
+		{
+			events.push_back(std::make_pair(p_event.getObjectA()->getID(), p_event.getObjectB()->getID()));
+			points.insert(points.end(), p_event.getIntersectionPoints().begin(), p_event.getIntersectionPoints().end());
+		}
+	};
+	
+	class BatchRecordingCollisionHandler : public RecordingCollisionHandler
+	{
+	public:
+		int batches;
+		
+		BatchRecordingCollisionHandler(): batches(0) { }
+		
+		void collideBatch(cdl::CollisionEventBuffer &p_events)
+		{
+			++batches;
+			for(unsigned int i = 0; i < p_events.size(); ++i) {
+				events.push_back(std::make_pair(p_events.getObjectA(i)->getID(), p_events.getObjectB(i)->getID()));
+				points.insert(points.end(), p_events.getIntersectionPoints(i), p_events.getIntersectionPoints(i) + p_events.getIntersectionPointCount(i));
+			}
+		}
+	};
+	
+	class ContactRecordingHandler : public RecordingCollisionHandler
+	{
+	public:
+		int begins, persists, ends;
+		
+		ContactRecordingHandler(): begins(0), persists(0), ends(0) { }
+		
+		void beginContact(cdl::CollisionEvent &p_event) { ++begins; }
+		void persistContact(cdl::CollisionEvent &p_event) { ++persists; }
+		void endContact(cdl::CollisionEvent &p_event) { ++ends; CHECK(p_event.getIntersectionPoints().empty()); }
+	};
+	
+	// creates the same scene of random circles and boxes in every given world
+	static void createRandomScene(cdl::World &p_world, const int p_count, const float p_size)
+	{
+		for(int i = 0; i < p_count; ++i) {
+			std::vector<cdl::Circle> circles;
+			std::vector<cdl::Polygon> polygons;
+			if(i % 2 == 0) {
+				circles.push_back(cdl::Circle(cdl::Vec2(0, 0), randomFloat(0.2f, 1.0f)));
+			} else {
+				cdl::Polygon polygon;
+				float halfSize = randomFloat(0.2f, 1.0f);
+				polygon.corners.push_back(cdl::Vec2(-halfSize, halfSize));
+				polygon.corners.push_back(cdl::Vec2(halfSize, halfSize));
+				polygon.corners.push_back(cdl::Vec2(halfSize, -halfSize));
+				polygon.corners.push_back(cdl::Vec2(-halfSize, -halfSize));
+				polygons.push_back(polygon);
+			}
+			
+			cdl::CollisionObject *obj = p_world.createObject(polygons, circles);
+			obj->position.set(randomFloat(-p_size, p_size), randomFloat(-p_size, p_size));
+			obj->linearVelocity.set(randomFloat(-1, 1), randomFloat(-1, 1));
+		}
+	}
+	
+	TEST(DestroyObject)
+	{
+		cdl::World world;
+		RecordingCollisionHandler handler;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		cdl::CollisionObject *objects[4];
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		for(int i = 0; i < 4; ++i)
+			objects[i] = world.createObject(polygons, circles);
+		world.setCollisionHandler(&handler);
+		
+		// remaining objects are still checked in order of creation
+		world.destroyObject(objects[1]);
+		world.step(1, 1);
+		CHECK(handler.events.size() == 3);
+		CHECK(handler.events[0] == std::make_pair(0u, 2u));
+		CHECK(handler.events[1] == std::make_pair(0u, 3u));
+		CHECK(handler.events[2] == std::make_pair(2u, 3u));
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(ObjectHandles)
+	{
+		cdl::World world;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *objA = world.createObject(polygons, circles);
+		cdl::CollisionObject *objB = world.createObject(polygons, circles);
+		cdl::ObjectHandle handleA = objA->getHandle();
+		cdl::ObjectHandle handleB = objB->getHandle();
+		CHECK(world.getObject(handleA) == objA);
+		CHECK(world.getObject(cdl::ObjectHandle()) == NULL);
+		
+		// memory of destroyed objects is reused, but their handles stay invalid
+		objA->linearVelocity.set(1, 1);
+		world.destroyObject(objA);
+		CHECK(world.getObject(handleA) == NULL);
+		cdl::CollisionObject *objC = world.createObject(polygons, std::vector<cdl::Circle>());
+		CHECK(objC == objA);
+		CHECK(objC->getHandle() != handleA);
+		CHECK(objC->getID() == 2);
+		CHECK(objC->circles().empty());
+		CHECK(objC->linearVelocity == cdl::Vec2(0, 0));
+		CHECK(world.getObject(objC->getHandle()) == objC);
+		
+		// destroying twice has no effect on the new object
+		world.destroyObject(objB);
+		world.destroyObject(objB);
+		CHECK(world.getObject(objC->getHandle()) == objC);
+		
+		world.destroyAllObjects();
+		CHECK(world.getObject(handleB) == NULL);
+		CHECK(world.getObject(objC->getHandle()) == NULL);
+	}
+	
+	TEST(SpatialHashGridMatchesBruteForce)
+	{
+		cdl::World bruteForceWorld, gridWorld;
+		RecordingCollisionHandler bruteForceHandler, gridHandler;
+		cdl::SpatialHashGrid grid(1.5f);
+		
+		srand(42);
+		createRandomScene(bruteForceWorld, 200, 15);
+		srand(42);
+		createRandomScene(gridWorld, 200, 15);
+		
+		bruteForceWorld.setCollisionHandler(&bruteForceHandler);
+		gridWorld.setCollisionHandler(&gridHandler);
+		gridWorld.setBroadphase(&grid);
+		
+		bruteForceWorld.step(1, 4);
+		gridWorld.step(1, 4);
+		
+		CHECK(!bruteForceHandler.events.empty());
+		CHECK(bruteForceHandler.events == gridHandler.events);
+		
+		bruteForceWorld.destroyAllObjects();
+		gridWorld.destroyAllObjects();
+	}
+	
+	TEST(SweepAndPruneMatchesBruteForce)
+	{
+		cdl::World bruteForceWorld, sapWorld;
+		RecordingCollisionHandler bruteForceHandler, sapHandler;
+		cdl::SweepAndPrune sweepAndPrune;
+		
+		srand(7);
+		createRandomScene(bruteForceWorld, 200, 15);
+		srand(7);
+		createRandomScene(sapWorld, 200, 15);
+		
+		bruteForceWorld.setCollisionHandler(&bruteForceHandler);
+		sapWorld.setCollisionHandler(&sapHandler);
+		sapWorld.setBroadphase(&sweepAndPrune);
+		
+		std::vector<cdl::Circle> circles;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *bruteForceExtra[10];
+		cdl::CollisionObject *sapExtra[10];
+		for(int i = 0; i < 10; ++i) {
+			bruteForceExtra[i] = bruteForceWorld.createObject(std::vector<cdl::Polygon>(), circles);
+			sapExtra[i] = sapWorld.createObject(std::vector<cdl::Polygon>(), circles);
+			bruteForceExtra[i]->position.set(i * 3.0f - 15, i * 2.0f - 10);
+			sapExtra[i]->position.set(i * 3.0f - 15, i * 2.0f - 10);
+		}
+		
+		// endpoints are kept between steps, removed objects leave marked endpoints behind
+		for(int i = 0; i < 3; ++i) {
+			bruteForceWorld.step(1, 4);
+			sapWorld.step(1, 4);
+			for(int j = i; j < 10; j += 3) {
+				bruteForceWorld.destroyObject(bruteForceExtra[j]);
+				sapWorld.destroyObject(sapExtra[j]);
+			}
+		}
+		bruteForceWorld.step(1, 4);
+		sapWorld.step(1, 4);
+		
+		CHECK(!bruteForceHandler.events.empty());
+		CHECK(bruteForceHandler.events == sapHandler.events);
+		
+		bruteForceWorld.destroyAllObjects();
+		sapWorld.destroyAllObjects();
+	}
+	
+	TEST(DynamicAABBTreeMatchesBruteForce)
+	{
+		cdl::World bruteForceWorld, treeWorld;
+		RecordingCollisionHandler bruteForceHandler, treeHandler;
+		cdl::DynamicAABBTree tree(0.5f);
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		
+		// objects of very different sizes
+		srand(13);
+		createRandomScene(bruteForceWorld, 200, 15);
+		srand(13);
+		createRandomScene(treeWorld, 200, 15);
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 6));
+		cdl::CollisionObject *bruteForceBig = bruteForceWorld.createObject(polygons, circles);
+		cdl::CollisionObject *treeBig = treeWorld.createObject(polygons, circles);
+		bruteForceBig->position.set(3, -2);
+		treeBig->position.set(3, -2);
+		
+		bruteForceWorld.setCollisionHandler(&bruteForceHandler);
+		treeWorld.setCollisionHandler(&treeHandler);
+		treeWorld.setBroadphase(&tree);
+		
+		// leaves are kept between steps and only moved when objects leave their fat bounds
+		for(int i = 0; i < 3; ++i) {
+			bruteForceWorld.step(1, 4);
+			treeWorld.step(1, 4);
+		}
+		CHECK(tree.getHeight() < 20);
+		
+		bruteForceWorld.destroyObject(bruteForceBig);
+		treeWorld.destroyObject(treeBig);
+		bruteForceWorld.step(1, 4);
+		treeWorld.step(1, 4);
+		
+		CHECK(!bruteForceHandler.events.empty());
+		CHECK(bruteForceHandler.events == treeHandler.events);
+		
+		treeWorld.setBroadphase(NULL);
+		bruteForceWorld.destroyAllObjects();
+		treeWorld.destroyAllObjects();
+	}
+	
+	TEST(OverlapNarrowphase)
+	{
+		cdl::World world;
+		RecordingCollisionHandler handler;
+		std::vector<cdl::Polygon> polygons;
+		cdl::Polygon polygon;
+		
+		polygon.corners.push_back(cdl::Vec2(-1, 1));
+		polygon.corners.push_back(cdl::Vec2(1, 1));
+		polygon.corners.push_back(cdl::Vec2(1, -1));
+		polygon.corners.push_back(cdl::Vec2(-1, -1));
+		polygons.push_back(polygon);
+		cdl::CollisionObject *big = world.createObject(polygons, std::vector<cdl::Circle>());
+		std::vector<cdl::Circle> circles;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.5f));
+		cdl::CollisionObject *small = world.createObject(std::vector<cdl::Polygon>(), circles);
+		world.setCollisionHandler(&handler);
+		
+		// circle inside of box has no intersection points
+		world.step(1, 1);
+		CHECK(handler.events.empty());
+		
+		world.setNarrowphase(cdl::World::NARROWPHASE_OVERLAP);
+		world.step(1, 1);
+		CHECK(handler.events.size() == 1);
+		CHECK(handler.events[0] == std::make_pair(big->getID(), small->getID()));
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(SeparatingAxisNarrowphase)
+	{
+		cdl::World overlapWorld, satWorld;
+		RecordingCollisionHandler overlapHandler, satHandler;
+		
+		srand(11);
+		createRandomScene(overlapWorld, 100, 8);
+		srand(11);
+		createRandomScene(satWorld, 100, 8);
+		
+		// all shapes are convex, both find the same overlapping objects
+		overlapWorld.setCollisionHandler(&overlapHandler);
+		overlapWorld.setNarrowphase(cdl::World::NARROWPHASE_OVERLAP);
+		satWorld.setCollisionHandler(&satHandler);
+		satWorld.setNarrowphase(cdl::World::NARROWPHASE_SAT);
+		
+		overlapWorld.step(1, 2);
+		satWorld.step(1, 2);
+		
+		CHECK(!overlapHandler.events.empty());
+		CHECK(overlapHandler.events == satHandler.events);
+		
+		overlapWorld.destroyAllObjects();
+		satWorld.destroyAllObjects();
+	}
+
+	TEST(GJKNarrowphase)
+	{
+		cdl::World overlapWorld, gjkWorld;
+		RecordingCollisionHandler overlapHandler, gjkHandler;
+		
+		srand(13);
+		createRandomScene(overlapWorld, 100, 8);
+		srand(13);
+		createRandomScene(gjkWorld, 100, 8);
+		
+		// all shapes are convex, both find the same overlapping objects
+		overlapWorld.setCollisionHandler(&overlapHandler);
+		overlapWorld.setNarrowphase(cdl::World::NARROWPHASE_OVERLAP);
+		gjkWorld.setCollisionHandler(&gjkHandler);
+		gjkWorld.setNarrowphase(cdl::World::NARROWPHASE_GJK);
+		
+		overlapWorld.step(1, 2);
+		gjkWorld.step(1, 2);
+		
+		CHECK(!overlapHandler.events.empty());
+		CHECK(overlapHandler.events == gjkHandler.events);
+		
+		overlapWorld.destroyAllObjects();
+		gjkWorld.destroyAllObjects();
+	}
+	
+	TEST(MultithreadedMatchesSingleThread)
+	{
+		cdl::World singleWorld, parallelWorld, parallelGridWorld;
+		RecordingCollisionHandler singleHandler, parallelHandler, parallelGridHandler;
+		cdl::SpatialHashGrid grid(1.5f);
+		
+		srand(23);
+		createRandomScene(singleWorld, 300, 15);
+		srand(23);
+		createRandomScene(parallelWorld, 300, 15);
+		srand(23);
+		createRandomScene(parallelGridWorld, 300, 15);
+		
+		singleWorld.setCollisionHandler(&singleHandler);
+		parallelWorld.setCollisionHandler(&parallelHandler);
+		parallelWorld.setThreadCount(4);
+		parallelGridWorld.setCollisionHandler(&parallelGridHandler);
+		parallelGridWorld.setThreadCount(3);
+		parallelGridWorld.setBroadphase(&grid);
+		CHECK(parallelWorld.getThreadCount() == 4);
+		
+		// handler is called in the same order with the same points
+		singleWorld.step(1, 4);
+		parallelWorld.step(1, 4);
+		parallelGridWorld.step(1, 4);
+		
+		CHECK(!singleHandler.events.empty());
+		CHECK(singleHandler.events == parallelHandler.events);
+		CHECK(singleHandler.points == parallelHandler.points);
+		CHECK(singleHandler.events == parallelGridHandler.events);
+		CHECK(singleHandler.points == parallelGridHandler.points);
+		
+		singleWorld.destroyAllObjects();
+		parallelWorld.destroyAllObjects();
+		parallelGridWorld.destroyAllObjects();
+	}
+	
+	TEST(DeferredEventsMatchImmediate)
+	{
+		cdl::World immediateWorld, deferredWorld, batchWorld;
+		RecordingCollisionHandler immediateHandler, deferredHandler;
+		BatchRecordingCollisionHandler batchHandler;
+		
+		srand(7);
+		createRandomScene(immediateWorld, 200, 15);
+		srand(7);
+		createRandomScene(deferredWorld, 200, 15);
+		srand(7);
+		createRandomScene(batchWorld, 200, 15);
+		
+		immediateWorld.setCollisionHandler(&immediateHandler);
+		deferredWorld.setCollisionHandler(&deferredHandler);
+		deferredWorld.setDeferredEvents(true);
+		batchWorld.setCollisionHandler(&batchHandler);
+		batchWorld.setDeferredEvents(true);
+		batchWorld.setThreadCount(2);
+		
+		// handlers without collideBatch() still get every event through collide()
+		immediateWorld.step(1, 4);
+		deferredWorld.step(1, 4);
+		batchWorld.step(1, 4);
+		
+		CHECK(!immediateHandler.events.empty());
+		CHECK(immediateHandler.events == deferredHandler.events);
+		CHECK(immediateHandler.points == deferredHandler.points);
+		CHECK(immediateHandler.events == batchHandler.events);
+		CHECK(immediateHandler.points == batchHandler.points);
+		// at most one batch per iteration
+		CHECK(batchHandler.batches > 0 && batchHandler.batches <= 4);
+		
+		immediateWorld.destroyAllObjects();
+		deferredWorld.destroyAllObjects();
+		batchWorld.destroyAllObjects();
+	}
+	
+	TEST(DeferredDefaultHandler)
+	{
+		cdl::World world;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *objA = world.createObject(polygons, circles);
+		cdl::CollisionObject *objB = world.createObject(polygons, circles);
+		objA->position.set(-3, 0);
+		objA->linearVelocity.set(1, 0);
+		objB->position.set(3, 0);
+		objB->linearVelocity.set(-1, 0);
+		world.setDeferredEvents(true);
+		
+		// velocities are reset once the batch of the colliding iteration is dispatched
+		world.step(2, 2);
+		CHECK(objA->linearVelocity == cdl::Vec2(0, 0));
+		CHECK(objB->linearVelocity == cdl::Vec2(0, 0));
+		CHECK(objA->position == cdl::Vec2(-1, 0));
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(AdaptiveSubsteps)
+	{
+		cdl::World world;
+		RecordingCollisionHandler handler;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		cdl::Polygon wall;
+		
+		wall.corners.push_back(cdl::Vec2(-0.1f, 5));
+		wall.corners.push_back(cdl::Vec2(0.1f, 5));
+		wall.corners.push_back(cdl::Vec2(0.1f, -5));
+		wall.corners.push_back(cdl::Vec2(-0.1f, -5));
+		polygons.push_back(wall);
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.5f));
+		world.createObject(polygons, std::vector<cdl::Circle>());
+		cdl::CollisionObject *restingA = world.createObject(std::vector<cdl::Polygon>(), circles);
+		cdl::CollisionObject *restingB = world.createObject(std::vector<cdl::Polygon>(), circles);
+		restingA->position.set(20, 0);
+		restingB->position.set(20.5f, 0);
+		world.setCollisionHandler(&handler);
+		world.setAdaptiveSubsteps(true);
+		
+		// without moving objects a single iteration is enough
+		world.step(1, 10);
+		CHECK(handler.events.size() == 1);
+		CHECK(handler.events[0] == std::make_pair(1u, 2u));
+		
+		// bullet takes all iterations, which lets it hit the wall at x = 0
+		cdl::CollisionObject *bullet = world.createObject(std::vector<cdl::Polygon>(), circles);
+		bullet->position.set(-10, 0);
+		bullet->linearVelocity.set(20, 0);
+		handler.events.clear();
+		world.step(1, 10);
+		CHECK(std::find(handler.events.begin(), handler.events.end(), std::make_pair(0u, 3u)) != handler.events.end());
+		// resting pair is still only checked once
+		CHECK(std::count(handler.events.begin(), handler.events.end(), std::make_pair(1u, 2u)) == 1);
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(StaticAndSleepingObjects)
+	{
+		cdl::World world;
+		RecordingCollisionHandler handler;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *staticA = world.createObject(polygons, circles);
+		cdl::CollisionObject *staticB = world.createObject(polygons, circles);
+		cdl::CollisionObject *restingA = world.createObject(polygons, circles);
+		cdl::CollisionObject *restingB = world.createObject(polygons, circles);
+		staticA->setStatic(true);
+		staticB->setStatic(true);
+		staticB->position.set(1, 0);
+		staticB->linearVelocity.set(1, 0);
+		restingA->position.set(10, 0);
+		restingB->position.set(11, 0);
+		world.setCollisionHandler(&handler);
+		world.setSleepIterations(2);
+		
+		// static objects neither move nor collide with each other, resting ones fall asleep
+		world.step(1, 5);
+		CHECK(staticB->position == cdl::Vec2(1, 0));
+		CHECK(restingA->isSleeping() && restingB->isSleeping());
+		CHECK(handler.events.size() == 2);
+		CHECK(handler.events[0] == std::make_pair(2u, 3u));
+		
+		// moving object wakes up the sleeping ones it touches
+		cdl::CollisionObject *mover = world.createObject(polygons, circles);
+		mover->position.set(10.5f, 2.5f);
+		mover->linearVelocity.set(0, -1);
+		handler.events.clear();
+		world.step(1, 1);
+		CHECK(!restingA->isSleeping() && !restingB->isSleeping());
+		CHECK(handler.events.size() == 2);
+		CHECK(handler.events[0] == std::make_pair(2u, 4u));
+		
+		// moving a sleeping object by hand wakes it up
+		world.step(1, 3);
+		mover->position.set(-10, 0);
+		mover->linearVelocity.set(0, 0);
+		world.step(1, 3);
+		CHECK(restingA->isSleeping());
+		restingA->position.set(0, 0);
+		world.step(1, 1);
+		CHECK(!restingA->isSleeping());
+		CHECK(std::find(handler.events.begin(), handler.events.end(), std::make_pair(0u, 2u)) != handler.events.end());
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(ContactEvents)
+	{
+		cdl::World world;
+		ContactRecordingHandler handler;
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 1));
+		cdl::CollisionObject *objA = world.createObject(polygons, circles);
+		cdl::CollisionObject *objB = world.createObject(polygons, circles);
+		objA->position.set(-3, 0);
+		objB->position.set(3, 0);
+		objB->linearVelocity.set(-1, 0);
+		world.setCollisionHandler(&handler);
+		world.setPairCache(true);
+		
+		// B touches A after 4 seconds and passes through it until it leaves after 8 seconds
+		world.step(10, 10);
+		CHECK(handler.begins == 1);
+		CHECK(handler.persists == handler.events.size() - 1);
+		CHECK(handler.ends == 1);
+		
+		// contact of a destroyed object ends without an event
+		objB->position.set(-2, 0);
+		objB->linearVelocity.set(0, 0);
+		world.step(1, 1);
+		CHECK(handler.begins == 2);
+		world.destroyObject(objB);
+		world.step(1, 1);
+		CHECK(handler.ends == 1);
+		
+		world.destroyAllObjects();
+	}
+	
+	TEST(PairCacheMatchesUncached)
+	{
+		cdl::World uncachedWorld, cachedWorld, cachedParallelWorld;
+		RecordingCollisionHandler uncachedHandler;
+		ContactRecordingHandler cachedHandler, cachedParallelHandler;
+		
+		srand(11);
+		createRandomScene(uncachedWorld, 200, 10);
+		srand(11);
+		createRandomScene(cachedWorld, 200, 10);
+		srand(11);
+		createRandomScene(cachedParallelWorld, 200, 10);
+		
+		uncachedWorld.setCollisionHandler(&uncachedHandler);
+		cachedWorld.setCollisionHandler(&cachedHandler);
+		cachedWorld.setPairCache(true);
+		cachedParallelWorld.setCollisionHandler(&cachedParallelHandler);
+		cachedParallelWorld.setPairCache(true);
+		cachedParallelWorld.setThreadCount(3);
+		
+		// separating axes only skip pairs that do not collide
+		for(int i = 0; i < 5; ++i) {
+			uncachedWorld.step(0.5f, 4);
+			cachedWorld.step(0.5f, 4);
+			cachedParallelWorld.step(0.5f, 4);
+		}
+		
+		CHECK(!uncachedHandler.events.empty());
+		CHECK(uncachedHandler.events == cachedHandler.events);
+		CHECK(uncachedHandler.points == cachedHandler.points);
+		CHECK(uncachedHandler.events == cachedParallelHandler.events);
+		CHECK(cachedHandler.begins + cachedHandler.persists == cachedHandler.events.size());
+		CHECK(cachedHandler.begins == cachedParallelHandler.begins);
+		CHECK(cachedHandler.ends == cachedParallelHandler.ends);
+		CHECK(cachedHandler.ends > 0);
+		
+		uncachedWorld.destroyAllObjects();
+		cachedWorld.destroyAllObjects();
+		cachedParallelWorld.destroyAllObjects();
+	}
+	
+	// static circles on a grid, so that the tree has enough shapes to be built in parallel
+	static void createStaticScene(cdl::World &p_world, std::vector<cdl::CollisionObject*> &p_objects)
+	{
+		std::vector<cdl::Circle> circles;
+		std::vector<cdl::Polygon> polygons;
+		circles.push_back(cdl::Circle(cdl::Vec2(0, 0), 0.3f));
+		circles.push_back(cdl::Circle(cdl::Vec2(0.5f, 0), 0.3f));
+		for(int x = 0; x < 20; ++x) {
+			for(int y = 0; y < 20; ++y) {
+				cdl::CollisionObject *obj = p_world.createObject(polygons, circles);
+				obj->position.set(x * 1.5f - 15, y * 1.5f - 15);
+				obj->setStatic(true);
+				p_objects.push_back(obj);
+			}
+		}
+	}
+	
+	TEST(StaticTreeMatchesBruteForce)
+	{
+		cdl::World worlds[3];
+		RecordingCollisionHandler handlers[3];
+		std::vector<cdl::CollisionObject*> staticObjects[3];
+		cdl::SpatialHashGrid grid(2);
+		
+		for(int i = 0; i < 3; ++i) {
+			srand(5);
+			createRandomScene(worlds[i], 150, 15);
+			createStaticScene(worlds[i], staticObjects[i]);
+			worlds[i].setCollisionHandler(&handlers[i]);
+		}
+		worlds[1].setStaticTree(true);
+		worlds[2].setStaticTree(true);
+		worlds[2].setThreadCount(3);
+		worlds[2].setBroadphase(&grid);
+		
+		for(int i = 0; i < 3; ++i)
+			worlds[i].step(1, 4);
+		
+		// tree is rebuilt after static objects were moved or destroyed
+		for(int i = 0; i < 3; ++i) {
+			staticObjects[i][0]->position.set(0, 0);
+			staticObjects[i][1]->setDirection(1);
+			worlds[i].destroyObject(staticObjects[i][2]);
+			worlds[i].step(1, 4);
+		}
+		
+		CHECK(!handlers[0].events.empty());
+		CHECK(handlers[0].events == handlers[1].events);
+		CHECK(handlers[0].points == handlers[1].points);
+		CHECK(handlers[0].events == handlers[2].events);
+		CHECK(handlers[0].points == handlers[2].points);
+		
+		worlds[2].setBroadphase(NULL);
+		for(int i = 0; i < 3; ++i)
+			worlds[i].destroyAllObjects();
+	}
+	
+	TEST(ContinuousMatchesBruteForce)
+	{
+		cdl::World worlds[5];
+		RecordingCollisionHandler handlers[5];
+		std::vector<cdl::CollisionObject*> staticObjects[5];
+		cdl::SweepAndPrune sweepAndPrune;
+		cdl::DynamicAABBTree tree;
+		cdl::SpatialHashGrid grid(2);
+		
+		for(int i = 0; i < 5; ++i) {
+			srand(17);
+			createRandomScene(worlds[i], 150, 15);
+			createStaticScene(worlds[i], staticObjects[i]);
+			worlds[i].setCollisionHandler(&handlers[i]);
+			worlds[i].setContinuous(true);
+		}
+		worlds[1].setBroadphase(&sweepAndPrune);
+		worlds[2].setBroadphase(&tree);
+		worlds[3].setBroadphase(&grid);
+		worlds[3].setThreadCount(3);
+		worlds[4].setStaticTree(true);
+		worlds[4].setThreadCount(2);
+		
+		// swept pairs are found by the broadphases and the tree, objects stop at the same time
+		for(int i = 0; i < 5; ++i) {
+			worlds[i].step(1, 4);
+			staticObjects[i][0]->position.set(0, 0);
+			worlds[i].step(1, 4);
+		}
+		
+		CHECK(!handlers[0].events.empty());
+		for(int i = 1; i < 5; ++i) {
+			CHECK(handlers[0].events == handlers[i].events);
+			CHECK(handlers[0].points == handlers[i].points);
+		}
+		
+		for(int i = 1; i < 4; ++i)
+			worlds[i].setBroadphase(NULL);
+		for(int i = 0; i < 5; ++i)
+			worlds[i].destroyAllObjects();
+	}
+	
+	TEST(StepStats)
+	{
+		cdl::World world, parallelWorld;
+		RecordingCollisionHandler handler, parallelHandler;
+		
+		srand(23);
+		createRandomScene(world, 200, 10);
+		srand(23);
+		createRandomScene(parallelWorld, 200, 10);
+		world.setCollisionHandler(&handler);
+		parallelWorld.setCollisionHandler(&parallelHandler);
+		parallelWorld.setThreadCount(3);
+		world.step(1, 4);
+		parallelWorld.step(1, 4);
+		
+		const cdl::StepStats &stats = world.getStepStats();
+		const cdl::StepStats &parallelStats = parallelWorld.getStepStats();
+#ifdef CDL_PROFILING
+		CHECK(stats.pairsTested > 0);
+		CHECK(stats.pairsConsidered >= stats.pairsTested);
+		CHECK(stats.shapeTests >= handler.events.size());
+		CHECK(stats.intersectionPoints == handler.points.size());
+		CHECK(stats.narrowphaseSec > 0);
+		CHECK(stats.integrationSec > 0);
+		
+		// workers count the same shape tests
+		CHECK(parallelStats.pairsTested == stats.pairsTested);
+		CHECK(parallelStats.shapeTests == stats.shapeTests);
+		CHECK(parallelStats.intersectionPoints == stats.intersectionPoints);
+#else
+		// nothing is measured
+		CHECK(stats.pairsTested == 0 && stats.shapeTests == 0 && stats.narrowphaseSec == 0);
+		CHECK(parallelStats.pairsTested == 0);
+#endif
+		
+		world.destroyAllObjects();
+		parallelWorld.destroyAllObjects();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+/* Shape and random helpers shared by the CDL test suites. */
+
+#ifndef CDL_TEST_SHAPES_HPP
+#define CDL_TEST_SHAPES_HPP
+
+#include <cdl/cdl.hpp>
+#include <cstdlib>
+
+static inline cdl::Polygon createBox(const cdl::Vec2 &p_mid, const float p_halfWidth, const float p_halfHeight)
+{
+	cdl::Polygon result;
+	result.corners.push_back(p_mid + cdl::Vec2(-p_halfWidth, p_halfHeight));
+	result.corners.push_back(p_mid + cdl::Vec2(p_halfWidth, p_halfHeight));
+	result.corners.push_back(p_mid + cdl::Vec2(p_halfWidth, -p_halfHeight));
+	result.corners.push_back(p_mid + cdl::Vec2(-p_halfWidth, -p_halfHeight));
+	return result;
+}
+
+static inline float randomFloat(const float p_min, const float p_max)
+{
+	return p_min + (p_max - p_min) * (rand() / (float) RAND_MAX);
+}
+
+#endif